@@ -3,11 +3,14 @@
 
 #include <algorithm>
 #include <functional>
+#include <utility>
 #include <vector>
 
 
 class AlphaT {
 public:
+  AlphaT();
+
   template <class T>
   AlphaT(std::vector<T const *> const & p4, bool use_et = true);
 
@@ -19,18 +22,65 @@ private:
   std::vector<double> px_;
   std::vector<double> py_;
 
+  // |Delta HT| of all the pseudo-jet partitions, updated by push_back()
+  std::vector<double> delta_sum_et_;
+
+  // minimum |Delta HT| of the current jets, if known: kept up to date by push_back() for
+  // small collections, otherwise computed on demand by value() or passes() and cached
+  mutable double min_delta_sum_et_;
+  mutable bool   min_delta_sum_et_valid_;
+
+  // work space of the greedy and meet-in-the-middle algorithms, kept to reuse its memory
+  // across the calls: the latter needs about 16 MB at max_jets_
+  mutable std::vector<double> sorted_et_;
+  mutable std::vector<double> low_;
+  mutable std::vector<std::pair<double, unsigned long long> > high_;
+
 public:
+  // above this number of jets AlphaT is not computed, and value() returns a very large number;
+  // the meet-in-the-middle algorithm needs 2^(n/2) entries for each half of the jets
+  static const unsigned int max_jets_ = 40;
+
+  // add one jet, updating the reachable partitions incrementally
+  template <class T>
+  void push_back(T const & p4, bool use_et = true);
+
   inline double value(void) const;
   inline double value(std::vector<bool> & jet_sign) const;
 
+  // equivalent to value() > threshold, but stops as soon as the decision is known
+  bool passes(double threshold) const;
+
 private:
+  // above this number of jets, use the meet-in-the-middle algorithm instead of the brute force
+  // enumeration or the incremental update of the reachable partitions
+  static const unsigned int max_brute_force_jets_ = 12;
+
+  void update_(void);
+  void extend_(double et);
+
   double value_(std::vector<bool> * jet_sign) const;
+  double min_delta_sum_et_greedy_(void) const;
+  // the search stops as soon as a partition with |Delta HT| < target is found
+  double min_delta_sum_et_brute_force_(double sum_et, std::vector<bool> * jet_sign, double target = 0.) const;
+  double min_delta_sum_et_meet_in_the_middle_(double sum_et, std::vector<bool> * jet_sign, double target = 0.) const;
 };
 
 
+// -----------------------------------------------------------------------------
+inline
+AlphaT::AlphaT() :
+  min_delta_sum_et_(0.),
+  min_delta_sum_et_valid_(false)
+{
+}
+
 // -----------------------------------------------------------------------------
 template<class T>
-AlphaT::AlphaT(std::vector<T const *> const & p4, bool use_et /* = true */) {
+AlphaT::AlphaT(std::vector<T const *> const & p4, bool use_et /* = true */) :
+  min_delta_sum_et_(0.),
+  min_delta_sum_et_valid_(false)
+{
   std::transform( p4.begin(), p4.end(), back_inserter(et_), ( use_et ? std::mem_fun(&T::Et) : std::mem_fun(&T::Pt) ) );
   std::transform( p4.begin(), p4.end(), back_inserter(px_), std::mem_fun(&T::Px) );
   std::transform( p4.begin(), p4.end(), back_inserter(py_), std::mem_fun(&T::Py) );
@@ -38,12 +88,24 @@ AlphaT::AlphaT(std::vector<T const *> const & p4, bool use_et /* = true */) {
 
 // -----------------------------------------------------------------------------
 template<class T>
-AlphaT::AlphaT(std::vector<T> const & p4, bool use_et /* = true */) {
+AlphaT::AlphaT(std::vector<T> const & p4, bool use_et /* = true */) :
+  min_delta_sum_et_(0.),
+  min_delta_sum_et_valid_(false)
+{
   std::transform( p4.begin(), p4.end(), back_inserter(et_), std::mem_fun_ref( use_et ? &T::Et : &T::Pt ) );
   std::transform( p4.begin(), p4.end(), back_inserter(px_), std::mem_fun_ref(&T::Px) );
   std::transform( p4.begin(), p4.end(), back_inserter(py_), std::mem_fun_ref(&T::Py) );
 }
 
+// -----------------------------------------------------------------------------
+template<class T>
+void AlphaT::push_back(T const & p4, bool use_et /* = true */) {
+  et_.push_back( use_et ? p4.Et() : p4.Pt() );
+  px_.push_back( p4.Px() );
+  py_.push_back( p4.Py() );
+  update_();
+}
+
 
 // -----------------------------------------------------------------------------
 inline
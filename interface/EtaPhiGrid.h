@@ -0,0 +1,191 @@
+#ifndef HLTrigger_JetMET_EtaPhiGrid_h
+#define HLTrigger_JetMET_EtaPhiGrid_h
+
+/** \class EtaPhiGrid
+ *
+ *  DeltaR matching of directions to a set of points in (eta, phi).
+ *  The points are sorted into cells at least as large as the matching
+ *  distance, with phi wrapping around: the points within deltaR of a given
+ *  direction can only be in the 3x3 cells around it. The coordinates are
+ *  stored contiguously in cell order, and compared through deltaR^2.
+ *
+ *  Queries: matches() (any point within deltaR), first() (the lowest numbered
+ *  one), nearest(), within() (all the points within deltaR) and outside()
+ *  (the points farther than deltaR).
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "DataFormats/Math/interface/deltaPhi.h"
+
+
+class EtaPhiGrid {
+public:
+  // cells are no smaller than minCellSize, to keep their number small for tiny deltaR
+  explicit EtaPhiGrid(double deltaR, double minCellSize = 0.2) :
+    deltaR_(deltaR), deltaR2_(deltaR * deltaR), cellSize_(std::max(deltaR, minCellSize)),
+    etaMin_(0.), nEta_(0), nPhi_(std::max(1, int(2 * M_PI / cellSize_))), cellPhi_(2 * M_PI / nPhi_)
+  { }
+
+  static double deltaR2(double eta1, double phi1, double eta2, double phi2) {
+    const double deta = eta1 - eta2;
+    const double dphi = reco::deltaPhi(phi1, phi2);
+    return deta * deta + dphi * dphi;
+  }
+
+  // the points are numbered in the order they are added, and only
+  // kept in the cells after build(); clear() keeps the memory for the next event
+  void add(double eta, double phi) {
+    eta_.push_back(eta);
+    phi_.push_back(phi);
+  }
+
+  void clear() {
+    eta_.clear();
+    phi_.clear();
+  }
+
+  unsigned int size() const { return eta_.size(); }
+
+  void build() {
+    nEta_ = 0;
+    first_.clear();
+    points_.clear();
+    sortedEta_.clear();
+    sortedPhi_.clear();
+    if (eta_.empty()) return;
+
+    etaMin_ = *std::min_element(eta_.begin(), eta_.end());
+    double etaMax = *std::max_element(eta_.begin(), eta_.end());
+    nEta_ = int((etaMax - etaMin_) / cellSize_) + 1;
+
+    // counting sort of the points into the cells, keeping their order within a cell
+    cells_.resize(eta_.size());
+    first_.assign(nEta_ * nPhi_ + 1, 0);
+    for (unsigned int i = 0; i < eta_.size(); ++i) {
+      cells_[i] = etaBin(eta_[i]) * nPhi_ + phiBin(phi_[i]);
+      ++first_[cells_[i] + 1];
+    }
+    for (unsigned int c = 0; c < first_.size() - 1; ++c)
+      first_[c + 1] += first_[c];
+    next_.assign(first_.begin(), first_.end() - 1);
+    points_.resize(eta_.size());
+    sortedEta_.resize(eta_.size());
+    sortedPhi_.resize(eta_.size());
+    for (unsigned int i = 0; i < eta_.size(); ++i) {
+      unsigned int k = next_[cells_[i]]++;
+      points_[k]  = i;
+      sortedEta_[k] = eta_[i];
+      sortedPhi_[k] = phi_[i];
+    }
+  }
+
+  // true if a point is within deltaR of (eta, phi); stops at the first one found
+  bool matches(double eta, double phi) const {
+    bool found = false;
+    visit(eta, phi, false, [&found](unsigned int, double) { found = true; return true; });
+    return found;
+  }
+
+  // the lowest numbered point within deltaR of (eta, phi), or -1
+  int first(double eta, double phi) const {
+    int best = -1;
+    visit(eta, phi, false, [&best](unsigned int i, double) {
+        if (best < 0 || (int) i < best) best = i;
+        return false;
+      });
+    return best;
+  }
+
+  // the point nearest to (eta, phi) within deltaR, or -1; the lowest number wins ties
+  int nearest(double eta, double phi) const {
+    int best = -1;
+    double bestDR2 = 0.;
+    visit(eta, phi, false, [&best, &bestDR2](unsigned int i, double dr2) {
+        if (best < 0 || dr2 < bestDR2 || (dr2 == bestDR2 && (int) i < best)) {
+          best = i;
+          bestDR2 = dr2;
+        }
+        return false;
+      });
+    return best;
+  }
+
+  // the points within deltaR of (eta, phi), by increasing number
+  void within(double eta, double phi, std::vector<unsigned int>& indices) const {
+    indices.clear();
+    visit(eta, phi, false, [&indices](unsigned int i, double) { indices.push_back(i); return false; });
+    std::sort(indices.begin(), indices.end());
+  }
+
+  // the points farther than deltaR from (eta, phi), by increasing number;
+  // vetoed is work space, passed by the caller to reuse its memory
+  void outside(double eta, double phi, std::vector<unsigned int>& indices, std::vector<unsigned int>& vetoed) const {
+    vetoed.clear();
+    visit(eta, phi, true, [&vetoed](unsigned int i, double) { vetoed.push_back(i); return false; });
+    std::sort(vetoed.begin(), vetoed.end());
+    indices.clear();
+    for (unsigned int i = 0, v = 0; i < size(); ++i) {
+      if (v < vetoed.size() && vetoed[v] == i) ++v;
+      else indices.push_back(i);
+    }
+  }
+
+private:
+  int etaBin(double eta) const {
+    return std::min(int((eta - etaMin_) / cellSize_), nEta_ - 1);
+  }
+
+  int phiBin(double phi) const {
+    double x = reco::deltaPhi(phi, 0.) + M_PI;
+    return std::max(0, std::min(int(x / cellPhi_), nPhi_ - 1));
+  }
+
+  // calls f(number, deltaR^2) for the points within deltaR, or also at deltaR if inclusive, until it returns true
+  template <class F>
+  void visit(double eta, double phi, bool inclusive, F f) const {
+    if (nEta_ == 0 || deltaR_ < 0. || (deltaR_ == 0. && !inclusive)) return;
+
+    int ieta = int(std::floor((eta - etaMin_) / cellSize_));
+    if (ieta < -1 || ieta > nEta_) return;
+    int iphi = phiBin(phi);
+
+    // with fewer than 3 phi cells, each one is visited once
+    int dphiMin = nPhi_ < 3 ? -iphi : -1;
+    int dphiMax = nPhi_ < 3 ? nPhi_ - 1 - iphi : 1;
+    for (int e = std::max(ieta - 1, 0); e <= std::min(ieta + 1, nEta_ - 1); ++e) {
+      for (int dp = dphiMin; dp <= dphiMax; ++dp) {
+        int p = (iphi + dp + nPhi_) % nPhi_;
+        unsigned int cell = e * nPhi_ + p;
+        for (unsigned int k = first_[cell]; k < first_[cell + 1]; ++k) {
+          const double dr2 = deltaR2(eta, phi, sortedEta_[k], sortedPhi_[k]);
+          if ((inclusive ? dr2 <= deltaR2_ : dr2 < deltaR2_) && f(points_[k], dr2)) return;
+        }
+      }
+    }
+  }
+
+  double deltaR_;
+  double deltaR2_;
+  double cellSize_;
+  double etaMin_;
+  int nEta_;
+  int nPhi_;
+  double cellPhi_;
+  // points in the order they were added
+  std::vector<double> eta_;
+  std::vector<double> phi_;
+  // points of cell c at positions first_[c] to first_[c+1] of points_, sortedEta_ and sortedPhi_
+  std::vector<unsigned int> first_;
+  std::vector<unsigned int> points_;
+  std::vector<double> sortedEta_;
+  std::vector<double> sortedPhi_;
+  // work space of build(), kept to reuse its memory when the grid is refilled
+  std::vector<unsigned int> cells_;
+  std::vector<unsigned int> next_;
+};
+
+#endif // HLTrigger_JetMET_EtaPhiGrid_h
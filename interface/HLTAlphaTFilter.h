@@ -10,8 +10,10 @@
 #include "HLTrigger/HLTcore/interface/HLTFilter.h"
 
 #include "DataFormats/HLTReco/interface/TriggerFilterObjectWithRefs.h"
+#include "DataFormats/Common/interface/Handle.h"
 #include "DataFormats/JetReco/interface/CaloJetCollection.h"
 #include "DataFormats/JetReco/interface/PFJetCollection.h"
+#include "HLTrigger/JetMET/interface/JetKinematics.h"
 
 namespace edm {
    class ConfigurationDescriptions;
@@ -32,11 +34,19 @@ class HLTAlphaTFilter : public HLTFilter {
 
    private:
 
+      // adds the jets if the first nJets of jets pass the HT and AlphaT cuts, jets[i] being
+      // recojets[position(i)]; jets are the recojets, or their JetKinematics
+      template <class C, class P>
+      int addJets(C const & jets, unsigned int nJets, P position, edm::Handle<std::vector<T>> const & recojets, edm::Handle<std::vector<T>> const & recojetsFastJet, trigger::TriggerFilterObjectWithRefs & filterproduct) const;
+
       edm::EDGetTokenT<std::vector<T>> m_theRecoJetToken;
       edm::EDGetTokenT<std::vector<T>> m_theFastJetToken;
+      edm::EDGetTokenT<JetKinematics> m_theJetKinematicsToken;
 
       edm::InputTag inputJetTag_;           // input tag identifying jets
       edm::InputTag inputJetTagFastJet_;    // input tag identifying a second collection of jets
+      edm::InputTag jetKinematicsLabel_;    // optional JetKinematics of the first collection, used for its kinematics
+      bool useJetKinematics_;
       std::vector<double> minPtJet_;
       std::vector<double> etaJet_;
       unsigned int maxNJets_;
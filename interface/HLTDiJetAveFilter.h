@@ -10,6 +10,8 @@
 #include "DataFormats/HLTReco/interface/TriggerTypeDefs.h"
 #include "HLTrigger/HLTcore/interface/HLTFilter.h"
 #include "DataFormats/HLTReco/interface/TriggerFilterObjectWithRefs.h"
+#include "DataFormats/Common/interface/Handle.h"
+#include "HLTrigger/JetMET/interface/JetKinematics.h"
 
 namespace edm {
    class ConfigurationDescriptions;
@@ -29,12 +31,20 @@ class HLTDiJetAveFilter : public HLTFilter {
       virtual bool hltFilter(edm::Event&, const edm::EventSetup&, trigger::TriggerFilterObjectWithRefs & filterproduct) const override;
 
    private:
+      // adds the two leading of the nJets jets if they pass the cuts, jets[i] being
+      // objects[position(i)]; jets are the objects, or their JetKinematics
+      template <class C, class P>
+      int addDiJet(C const & jets, unsigned int nJets, P position, edm::Handle<std::vector<T>> const & objects, trigger::TriggerFilterObjectWithRefs & filterproduct) const;
+
       edm::EDGetTokenT<std::vector<T>> m_theJetToken;
+      edm::EDGetTokenT<JetKinematics> m_theJetKinematicsToken;
       edm::InputTag inputJetTag_; // input tag identifying jets
       double minPtAve_;
       double minPtJet3_;
       double minDphi_;
       int    triggerType_;
+      edm::InputTag jetKinematicsLabel_; // optional JetKinematics of the jets, used for their kinematics
+      bool   useJetKinematics_;
 };
 
 #endif //HLTDiJetAveFilter_h
@@ -11,6 +11,7 @@
 #include "HLTrigger/HLTcore/interface/HLTFilter.h"
 #include "DataFormats/HLTReco/interface/TriggerFilterObjectWithRefs.h"
 
+#include "DataFormats/Common/interface/View.h"
 #include "DataFormats/CaloTowers/interface/CaloTowerCollection.h"
 
 namespace edm {
@@ -31,7 +32,7 @@ class HLTExclDiJetFilter : public HLTFilter {
 
    private:
       edm::EDGetTokenT<std::vector<T>> m_theJetToken;
-      edm::EDGetTokenT<CaloTowerCollection> m_theCaloTowerCollectionToken;
+      edm::EDGetTokenT<edm::View<CaloTower> > m_theCaloTowerCollectionToken;   // CaloTowerCollection or RefVector of towers
       edm::InputTag inputJetTag_; // input tag identifying jets
       edm::InputTag caloTowerTag_; // input tag identifying caloTower collection
       double minPtJet_;
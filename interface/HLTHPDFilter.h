@@ -14,6 +14,8 @@
 #include "FWCore/Utilities/interface/InputTag.h"
 #include "DataFormats/HcalRecHit/interface/HcalRecHitCollections.h"
 
+class HcalHPDEnergyMap;
+
 namespace edm {
    class ConfigurationDescriptions;
 }
@@ -28,7 +30,10 @@ class HLTHPDFilter : public edm::EDFilter {
 
    private:
       edm::EDGetTokenT<HBHERecHitCollection> m_theRecHitCollectionToken;
+      edm::EDGetTokenT<HcalHPDEnergyMap> m_theHPDEnergyMapToken;
       edm::InputTag mInputTag; // input tag for HCAL HBHE digis
+      edm::InputTag mHPDEnergyMapTag; // optional HPD energies from HLTHcalHPDEnergyMapProducer
+      bool mUseHPDEnergyMap;
       double mEnergyThreshold;
       double mHPDSpikeEnergyThreshold;
       double mHPDSpikeIsolationEnergyThreshold;
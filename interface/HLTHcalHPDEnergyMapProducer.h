@@ -0,0 +1,36 @@
+#ifndef HLTHcalHPDEnergyMapProducer_h
+#define HLTHcalHPDEnergyMapProducer_h
+
+/** \class HLTHcalHPDEnergyMapProducer
+ *
+ *  Sums the HBHE rechit energy per HPD once per event, for HLTHPDFilter
+ *  and the other HCAL noise modules
+ *
+ */
+
+#include "FWCore/Framework/interface/EDProducer.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/Utilities/interface/InputTag.h"
+#include "DataFormats/HcalRecHit/interface/HcalRecHitCollections.h"
+
+namespace edm {
+   class ConfigurationDescriptions;
+}
+
+class HLTHcalHPDEnergyMapProducer : public edm::EDProducer {
+
+ public:
+  explicit HLTHcalHPDEnergyMapProducer(const edm::ParameterSet&);
+  ~HLTHcalHPDEnergyMapProducer();
+  static void fillDescriptions(edm::ConfigurationDescriptions & descriptions);
+  virtual void produce(edm::Event&, const edm::EventSetup&);
+
+ private:
+  edm::EDGetTokenT<HBHERecHitCollection> m_theRecHitCollectionToken;
+  // parameters
+  edm::InputTag inputTag_;    // HBHE rechits
+  double energyThreshold_;    // minimum rechit energy
+};
+
+#endif //HLTHcalHPDEnergyMapProducer_h
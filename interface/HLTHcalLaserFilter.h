@@ -37,6 +37,14 @@ class HLTHcalLaserFilter : public edm::EDFilter {
   std::vector<double> CalibChargeFilterValues_;
   double maxTotalCalibCharge_;
   int  maxAllowedHFcalib_;
+
+  // batch evaluation, used when the thresholds allow it (see the constructor)
+  bool passesBatch(const HcalCalibDigiCollection& digis) const;
+  bool useBatch_;
+  int adc2halffC_[128];                       // adc2fC in units of 0.5 fC, which is exact
+  std::vector<int> timeSliceWeights_;         // number of times each time slice appears in timeSlices_
+  std::vector<double> sortedThresholdsfC_;    // thresholdsfC_ in increasing order
+  std::vector<unsigned int> thresholdOrder_;  // position in thresholdsfC_ of each sorted threshold
 };
 
 #endif //HLTHcalLaserFilter_h
@@ -8,7 +8,7 @@
  */
 
 #include "FWCore/Framework/interface/EDFilter.h"
-#include "RecoMET/METAlgorithms/interface/HcalNoiseAlgo.h"
+#include "HLTrigger/JetMET/interface/HcalNoiseRBXSelector.h"
 #include "DataFormats/METReco/interface/HcalNoiseRBX.h"
 #include "DataFormats/METReco/interface/CaloMET.h"
 #include "DataFormats/METReco/interface/CaloMETCollection.h"
@@ -24,46 +24,25 @@ class HLTHcalMETNoiseCleaner : public edm::EDFilter {
   ~HLTHcalMETNoiseCleaner();
   static void fillDescriptions(edm::ConfigurationDescriptions & descriptions);
   virtual bool filter(edm::Event&, const edm::EventSetup&);
+  virtual void endJob();
   
  private:
   edm::EDGetTokenT<reco::CaloMETCollection> m_theCaloMetToken;
   edm::EDGetTokenT<reco::HcalNoiseRBXCollection> m_theHcalNoiseToken;
+  edm::EDGetTokenT<HcalNoiseRBXSummaryCollection> m_theHcalNoiseSummaryToken;
   // parameters
   edm::InputTag HcalNoiseRBXCollectionTag_;
+  edm::InputTag HcalNoiseRBXSummaryTag_;   // optional, from HLTHcalNoiseRBXSummaryProducer
+  bool useSummary_;
   edm::InputTag CaloMetCollectionTag_;
   double CaloMetCut_;
   int severity_;
   int maxNumRBXs_;
   int numRBXsToConsider_;
   bool accept2NoiseRBXEvents_;
-  bool needEMFCoincidence_;
-  double minRBXEnergy_;
-  double minRatio_;
-  double maxRatio_;
-  int minHPDHits_;
-  int minRBXHits_;
-  int minHPDNoOtherHits_;
-  int minZeros_;
-  double minHighEHitTime_;
-  double maxHighEHitTime_;
-  double maxRBXEMF_;
-
-  // imported from the RecoMET/METProducers/python/hcalnoiseinfoproducer_cfi
-  double minRecHitE_, minLowHitE_, minHighHitE_;
-
-  double TS4TS5EnergyThreshold_;
-  std::vector<std::pair<double, double> > TS4TS5UpperCut_;
-  std::vector<std::pair<double, double> > TS4TS5LowerCut_;  
+  HcalNoiseRBXSelector selector_;
 
   reco::CaloMET BuildCaloMet(float sumet,float pt,float phi);
-
-  // helper function to compare noise data energies
-  struct noisedatacomp {
-    inline bool operator() ( const CommonHcalNoiseRBXData& t1, const CommonHcalNoiseRBXData& t2) {
-      return t1.energy()>t2.energy();
-    }
-  };
-  typedef std::set<CommonHcalNoiseRBXData, noisedatacomp> noisedataset_t;
 };
 
 #endif //HLTHcalMETNoiseCleaner_h
@@ -0,0 +1,39 @@
+#ifndef HLTHcalNoiseRBXSummaryProducer_h
+#define HLTHcalNoiseRBXSummaryProducer_h
+
+/** \class HLTHcalNoiseRBXSummaryProducer
+ *
+ *  Computes the noise quantities and criteria of all RBXs once per event,
+ *  for HLTHcalMETNoiseFilter, HLTHcalMETNoiseCleaner and HLTHcalTowerNoiseCleaner
+ *
+ */
+
+#include "FWCore/Framework/interface/EDProducer.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/Utilities/interface/InputTag.h"
+#include "DataFormats/METReco/interface/HcalNoiseRBX.h"
+#include "HLTrigger/JetMET/interface/HcalNoiseRBXSelector.h"
+
+namespace edm {
+   class ConfigurationDescriptions;
+}
+
+class HLTHcalNoiseRBXSummaryProducer : public edm::EDProducer {
+
+ public:
+  explicit HLTHcalNoiseRBXSummaryProducer(const edm::ParameterSet&);
+  ~HLTHcalNoiseRBXSummaryProducer();
+  static void fillDescriptions(edm::ConfigurationDescriptions & descriptions);
+  virtual void produce(edm::Event&, const edm::EventSetup&);
+  virtual void endJob();
+
+ private:
+  edm::EDGetTokenT<reco::HcalNoiseRBXCollection> m_theHcalNoiseToken;
+  // parameters
+  edm::InputTag HcalNoiseRBXCollectionTag_;
+  int numRBXsToConsider_;   // negative: summarize all RBXs
+  HcalNoiseRBXSelector selector_;
+};
+
+#endif //HLTHcalNoiseRBXSummaryProducer_h
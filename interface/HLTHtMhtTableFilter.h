@@ -0,0 +1,76 @@
+#ifndef HLTHtMhtTableFilter_h_
+#define HLTHtMhtTableFilter_h_
+
+/** \class HLTHtMhtTableFilter
+ *
+ *  \brief  This filters events based on HT and MHT read from HtMhtTable products
+ *
+ *  As HLTHtMhtFilter, for HT and MHT computed from the jets above
+ *  `minPtJetHt_[i]` and `minPtJetMht_[i]`: several working points can be
+ *  checked on the same tables, without a producer for each of them.
+ *  HT (MHT) is 0 if fewer than `minNJetHt_[i]` (`minNJetMht_[i]`) jets pass.
+ *  An event is kept if at least one set satisfies:
+ *    - HT > `minHt_[i]` ; and
+ *    - MHT > `minMht_[i]` ; and
+ *    - sqrt(MHT + `meffSlope_[i]` * HT) > `minMeff_[i]`
+ *
+ *  The HT and MHT of each set are also put in the event as a reco::METCollection,
+ *  to be saved as TriggerTHT and TriggerMHT objects as HLTHtMhtFilter does: like
+ *  the output of HLTHtMhtProducer, each has the HT as sumEt and the MHT as p4.
+ *
+ */
+
+#include "HLTrigger/HLTcore/interface/HLTFilter.h"
+
+#include "DataFormats/METReco/interface/METCollection.h"
+#include "HLTrigger/JetMET/interface/HtMhtTable.h"
+
+
+namespace edm {
+    class ConfigurationDescriptions;
+}
+
+// Class declaration
+class HLTHtMhtTableFilter : public HLTFilter {
+  public:
+    explicit HLTHtMhtTableFilter(const edm::ParameterSet & iConfig);
+    ~HLTHtMhtTableFilter();
+    static void fillDescriptions(edm::ConfigurationDescriptions & descriptions);
+    virtual bool hltFilter(edm::Event & iEvent, const edm::EventSetup & iSetup, trigger::TriggerFilterObjectWithRefs & filterproduct) const override;
+
+  private:
+    /// Minimum jet pt (or et) requirements
+    std::vector<double> minPtJetHt_;
+    std::vector<double> minPtJetMht_;
+
+    /// Minimum number of jets passing the pt requirements
+    std::vector<int> minNJetHt_;
+    std::vector<int> minNJetMht_;
+
+    /// Minimum HT requirements
+    std::vector<double> minHt_;
+
+    /// Minimum MHT requirements
+    std::vector<double> minMht_;
+
+    /// Minimum Meff requirements
+    std::vector<double> minMeff_;
+
+    /// Meff slope requirements
+    std::vector<double> meffSlope_;
+
+    /// Input HtMhtTable products to retrieve HT and MHT
+    std::vector<edm::InputTag> htLabels_;
+    std::vector<edm::InputTag> mhtLabels_;
+
+    unsigned int nOrs_;  /// number of sets of requirements
+
+    /// Tag of the HT and MHT objects put by this module
+    edm::InputTag htMhtTag_;
+
+    std::vector<edm::EDGetTokenT<HtMhtTable> > m_theHtToken;
+    std::vector<edm::EDGetTokenT<HtMhtTable> > m_theMhtToken;
+};
+
+#endif  // HLTHtMhtTableFilter_h_
+
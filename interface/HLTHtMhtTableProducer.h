@@ -0,0 +1,50 @@
+#ifndef HLTHtMhtTableProducer_h_
+#define HLTHtMhtTableProducer_h_
+
+/** \class HLTHtMhtTableProducer
+ *
+ *  \brief  This produces a HtMhtTable, from which HT and MHT can be read for any jet threshold
+ *
+ *  The jets with |eta| < `maxEtaJet` are sorted by pt (or et, if `usePt` is
+ *  false), and the HT and MHT components are summed from the leading jet
+ *  down. PF muons are not subtracted.
+ *
+ */
+
+#include "FWCore/Framework/interface/EDProducer.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/EventSetup.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+
+#include "DataFormats/Common/interface/View.h"
+#include "DataFormats/JetReco/interface/Jet.h"
+#include "DataFormats/JetReco/interface/JetCollection.h"
+
+
+namespace edm {
+    class ConfigurationDescriptions;
+}
+
+// Class declaration
+class HLTHtMhtTableProducer : public edm::EDProducer {
+  public:
+    explicit HLTHtMhtTableProducer(const edm::ParameterSet & iConfig);
+    ~HLTHtMhtTableProducer();
+    static void fillDescriptions(edm::ConfigurationDescriptions & descriptions);
+    virtual void produce(edm::Event & iEvent, const edm::EventSetup & iSetup);
+
+  private:
+    /// Use pt; otherwise, use et.
+    bool usePt_;
+
+    /// Maximum (abs) eta requirement for jets
+    double maxEtaJet_;
+
+    /// Input jet collection
+    edm::InputTag jetsLabel_;
+
+    edm::EDGetTokenT<reco::JetView> m_theJetToken;
+};
+
+#endif  // HLTHtMhtTableProducer_h_
+
@@ -0,0 +1,48 @@
+#ifndef HLTJetKinematicsProducer_h_
+#define HLTJetKinematicsProducer_h_
+
+/** \class HLTJetKinematicsProducer
+ *
+ *  \brief  This produces the JetKinematics of a jet collection
+ *
+ *  The jets are read once per event, and HLTHtMhtProducer, HLTMhtProducer
+ *  and HLTMinDPhiMETFilter can use the arrays instead of the reco::Jet View.
+ *  Jets with pt <= `minPt` are not stored; a negative `minPt` keeps them all.
+ *  The consumers refuse preselected jets that could pass their own requirements.
+ *
+ */
+
+#include "FWCore/Framework/interface/EDProducer.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/EventSetup.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+
+#include "DataFormats/Common/interface/View.h"
+#include "DataFormats/JetReco/interface/Jet.h"
+#include "DataFormats/JetReco/interface/JetCollection.h"
+
+
+namespace edm {
+    class ConfigurationDescriptions;
+}
+
+// Class declaration
+class HLTJetKinematicsProducer : public edm::EDProducer {
+  public:
+    explicit HLTJetKinematicsProducer(const edm::ParameterSet & iConfig);
+    ~HLTJetKinematicsProducer();
+    static void fillDescriptions(edm::ConfigurationDescriptions & descriptions);
+    virtual void produce(edm::Event & iEvent, const edm::EventSetup & iSetup);
+
+  private:
+    /// Minimum pt requirement for jets
+    double minPt_;
+
+    /// Input jet collection
+    edm::InputTag jetsLabel_;
+
+    edm::EDGetTokenT<reco::JetView> m_theJetToken;
+};
+
+#endif  // HLTJetKinematicsProducer_h_
+
@@ -15,6 +15,8 @@
 #include "DataFormats/JetReco/interface/PFJetCollection.h"
 #include "DataFormats/JetReco/interface/TrackJetCollection.h"
 #include "DataFormats/JetReco/interface/BasicJetCollection.h"
+#include "DataFormats/Common/interface/RefVector.h"
+#include "HLTrigger/JetMET/interface/EtaPhiGrid.h"
 
 #include<typeinfo>
 
@@ -37,6 +39,8 @@ class HLTJetL1MatchProducer : public edm::EDProducer {
   edm::InputTag L1ForJets_;
   //  std::string jetType_;
   double DeltaR_;         // DeltaR(HLT,L1)
+  bool produceRefs_;      // put a RefVector to the matched jets instead of copying them
+  EtaPhiGrid l1Grid_;     // L1 jets of the event
 };
 
 #endif
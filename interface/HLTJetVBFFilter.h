@@ -10,6 +10,8 @@
 #include "DataFormats/HLTReco/interface/TriggerTypeDefs.h"
 #include "HLTrigger/HLTcore/interface/HLTFilter.h"
 #include "DataFormats/HLTReco/interface/TriggerFilterObjectWithRefs.h"
+#include "DataFormats/Common/interface/Handle.h"
+#include "HLTrigger/JetMET/interface/JetKinematics.h"
 
 namespace edm {
    class ConfigurationDescriptions;
@@ -29,6 +31,11 @@ class HLTJetVBFFilter : public HLTFilter {
       virtual bool hltFilter(edm::Event&, const edm::EventSetup&, trigger::TriggerFilterObjectWithRefs & filterproduct) const override;
 
    private:
+      // adds the pairs among the first nJets of jets that pass the VBF cuts, jets[i] being
+      // objects[position(i)]; jets are the objects, or their JetKinematics
+      template <class C, class P>
+      int addPairs(C const & jets, unsigned int nJets, P position, edm::Handle<std::vector<T>> const & objects, trigger::TriggerFilterObjectWithRefs & filterproduct) const;
+
       edm::InputTag inputTag_; // input tag identifying jets
       edm::EDGetTokenT<std::vector<T>> m_theObjectToken;
       double minPtLow_;
@@ -39,6 +46,9 @@ class HLTJetVBFFilter : public HLTFilter {
       double maxEta_;
       bool   leadingJetOnly_;
       int    triggerType_;
+      edm::InputTag jetKinematicsLabel_; // optional JetKinematics of the jets, used for their kinematics
+      bool   useJetKinematics_;
+      edm::EDGetTokenT<JetKinematics> m_theJetKinematicsToken;
 };
 
 #endif //HLTJetVBFFilter_h
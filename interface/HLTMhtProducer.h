@@ -24,6 +24,8 @@
 #include "DataFormats/METReco/interface/METFwd.h"
 #include "DataFormats/ParticleFlowCandidate/interface/PFCandidate.h"
 #include "DataFormats/ParticleFlowCandidate/interface/PFCandidateFwd.h"
+#include "HLTrigger/JetMET/interface/PFLightCandidates.h"
+#include "HLTrigger/JetMET/interface/JetKinematics.h"
 
 
 namespace edm {
@@ -39,6 +41,10 @@ class HLTMhtProducer : public edm::EDProducer {
     virtual void produce(edm::Event & iEvent, const edm::EventSetup & iSetup);
 
   private:
+    /// Adds a jet, or a JetKinematics::Element, to the sums if it passes the requirements
+    template <class J>
+    void addJet(J const & jet, int & nj, double & sumet, double & mhx, double & mhy) const;
+
     /// Use pt; otherwise, use et.
     bool usePt_;
 
@@ -59,8 +65,18 @@ class HLTMhtProducer : public edm::EDProducer {
     edm::InputTag jetsLabel_;
     edm::InputTag pfCandidatesLabel_;
 
+    /// Optional JetKinematics, used instead of the jet collection
+    edm::InputTag jetKinematicsLabel_;
+    bool useJetKinematics_;
+
+    /// Optional PFLightCandidates, used instead of the PFCandidate collection
+    edm::InputTag pfLightCandidatesLabel_;
+    bool usePFLightCandidates_;
+
     edm::EDGetTokenT<reco::JetView> m_theJetToken;
+    edm::EDGetTokenT<JetKinematics> m_theJetKinematicsToken;
     edm::EDGetTokenT<reco::PFCandidateCollection> m_thePFCandidateToken;
+    edm::EDGetTokenT<PFLightCandidates> m_thePFLightCandidateToken;
 };
 
 #endif  // HLTMhtProducer_h_
@@ -19,6 +19,7 @@
 #include "DataFormats/METReco/interface/METFwd.h"
 #include "DataFormats/JetReco/interface/Jet.h"
 #include "DataFormats/JetReco/interface/JetCollection.h"
+#include "HLTrigger/JetMET/interface/JetKinematics.h"
 
 
 namespace edm {
@@ -34,6 +35,10 @@ class HLTMinDPhiMETFilter : public HLTFilter {
     virtual bool hltFilter(edm::Event & iEvent, const edm::EventSetup & iSetup, trigger::TriggerFilterObjectWithRefs & filterproduct) const override;
 
   private:
+    /// Updates the min delta phi with a jet, or a JetKinematics::Element, if it passes the requirements
+    template <class J>
+    void updateMinDPhi(J const & jet, double metphi, double & minDPhi) const;
+
     /// Use pt; otherwise, use et.
     bool usePt_;
 
@@ -59,9 +64,14 @@ class HLTMinDPhiMETFilter : public HLTFilter {
     edm::InputTag calometLabel_;  // only used if metLabel_ is empty
     edm::InputTag jetsLabel_;
 
+    /// Optional JetKinematics, used instead of the jet collection
+    edm::InputTag jetKinematicsLabel_;
+    bool useJetKinematics_;
+
     edm::EDGetTokenT<reco::METCollection> m_theMETToken;
     edm::EDGetTokenT<reco::CaloMETCollection> m_theCaloMETToken;
     edm::EDGetTokenT<reco::JetView> m_theJetToken;
+    edm::EDGetTokenT<JetKinematics> m_theJetKinematicsToken;
 };
 
 #endif  // HLTMinDPhiMETFilter_h_
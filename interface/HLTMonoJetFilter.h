@@ -10,6 +10,8 @@
 #include "DataFormats/HLTReco/interface/TriggerTypeDefs.h"
 #include "HLTrigger/HLTcore/interface/HLTFilter.h"
 #include "DataFormats/HLTReco/interface/TriggerFilterObjectWithRefs.h"
+#include "DataFormats/Common/interface/Handle.h"
+#include "HLTrigger/JetMET/interface/JetKinematics.h"
 
 namespace edm {
    class ConfigurationDescriptions;
@@ -29,11 +31,19 @@ class HLTMonoJetFilter : public HLTFilter {
       virtual bool hltFilter(edm::Event&, const edm::EventSetup&, trigger::TriggerFilterObjectWithRefs & filterproduct) const override;
 
    private:
+      // returns 1 and adds the two leading of the nJets jets if they pass the cuts, -1 otherwise,
+      // jets[i] being objects[position(i)]; jets are the objects, or their JetKinematics
+      template <class C, class P>
+      int addMonoJet(C const & jets, unsigned int nJets, P position, edm::Handle<std::vector<T>> const & objects, trigger::TriggerFilterObjectWithRefs & filterproduct) const;
+
       edm::InputTag inputJetTag_;   // input tag identifying jets
       edm::EDGetTokenT<std::vector<T>> m_theObjectToken;
       double maxPtSecondJet_;
       double maxDeltaPhi_;
       int    triggerType_;
+      edm::InputTag jetKinematicsLabel_; // optional JetKinematics of the jets, used for their kinematics
+      bool   useJetKinematics_;
+      edm::EDGetTokenT<JetKinematics> m_theJetKinematicsToken;
 };
 
 #endif //HLTMonoJetFilter_h
@@ -0,0 +1,84 @@
+#ifndef HLTMultiHtMhtProducer_h_
+#define HLTMultiHtMhtProducer_h_
+
+/** \class HLTMultiHtMhtProducer
+ *
+ *  \brief  This produces one reco::MET object storing HT and MHT per working point
+ *
+ *  Equivalent to several HLTHtMhtProducer instances reading the same jets:
+ *  each PSet of `workingPoints` takes the HLTHtMhtProducer thresholds and a
+ *  `label`, used as product instance name of its reco::METCollection.
+ *  The jets are read once into plain arrays, which all working points share.
+ *  An HLTMhtProducer is emulated by equal Ht and Mht thresholds, and
+ *  minNJetHt = minNJetMht.
+ *
+ */
+
+#include <string>
+#include <vector>
+
+#include "FWCore/Framework/interface/EDProducer.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/EventSetup.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+
+#include "DataFormats/Common/interface/View.h"
+#include "DataFormats/JetReco/interface/Jet.h"
+#include "DataFormats/JetReco/interface/JetCollection.h"
+#include "DataFormats/METReco/interface/MET.h"
+#include "DataFormats/METReco/interface/METFwd.h"
+#include "DataFormats/ParticleFlowCandidate/interface/PFCandidate.h"
+#include "DataFormats/ParticleFlowCandidate/interface/PFCandidateFwd.h"
+
+
+namespace edm {
+    class ConfigurationDescriptions;
+}
+
+// Class declaration
+class HLTMultiHtMhtProducer : public edm::EDProducer {
+  public:
+    explicit HLTMultiHtMhtProducer(const edm::ParameterSet & iConfig);
+    ~HLTMultiHtMhtProducer();
+    static void fillDescriptions(edm::ConfigurationDescriptions & descriptions);
+    virtual void produce(edm::Event & iEvent, const edm::EventSetup & iSetup);
+
+  private:
+    /// Requirements of one working point, as in HLTHtMhtProducer
+    struct WorkingPoint {
+        explicit WorkingPoint(const edm::ParameterSet & pset);
+
+        std::string label;
+        bool usePt;
+        bool excludePFMuons;
+        int minNJetHt;
+        int minNJetMht;
+        double minPtJetHt;
+        double minPtJetMht;
+        double maxEtaJetHt;
+        double maxEtaJetMht;
+    };
+
+    std::vector<WorkingPoint> workingPoints_;
+
+    /// The jet quantities are only computed if a working point needs them
+    bool needPt_;
+    bool needEt_;
+    bool needPFMuons_;
+
+    /// Input jet, PFCandidate collections
+    edm::InputTag jetsLabel_;
+    edm::InputTag pfCandidatesLabel_;
+
+    edm::EDGetTokenT<reco::JetView> m_theJetToken;
+    edm::EDGetTokenT<reco::PFCandidateCollection> m_thePFCandidateToken;
+
+    /// Jets and PF muons of the event, one array per quantity
+    std::vector<double> jetPt_, jetPx_, jetPy_;
+    std::vector<double> jetEt_, jetEx_, jetEy_;
+    std::vector<double> jetAbsEta_;
+    std::vector<double> muonPx_, muonPy_;
+};
+
+#endif  // HLTMultiHtMhtProducer_h_
+
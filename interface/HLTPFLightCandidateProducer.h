@@ -0,0 +1,42 @@
+#ifndef HLTPFLightCandidateProducer_h_
+#define HLTPFLightCandidateProducer_h_
+
+/** \class HLTPFLightCandidateProducer
+ *
+ *  \brief  This produces the PFLightCandidates of a reco::PFCandidateCollection
+ *
+ *  The PF candidates are read once per event, and HLTTrackMETProducer,
+ *  HLTHtMhtProducer and HLTMhtProducer can use the compact arrays instead.
+ *
+ */
+
+#include "FWCore/Framework/interface/EDProducer.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/EventSetup.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+
+#include "DataFormats/ParticleFlowCandidate/interface/PFCandidate.h"
+#include "DataFormats/ParticleFlowCandidate/interface/PFCandidateFwd.h"
+
+
+namespace edm {
+    class ConfigurationDescriptions;
+}
+
+// Class declaration
+class HLTPFLightCandidateProducer : public edm::EDProducer {
+  public:
+    explicit HLTPFLightCandidateProducer(const edm::ParameterSet & iConfig);
+    ~HLTPFLightCandidateProducer();
+    static void fillDescriptions(edm::ConfigurationDescriptions & descriptions);
+    virtual void produce(edm::Event & iEvent, const edm::EventSetup & iSetup);
+
+  private:
+    /// Input PFCandidate collection
+    edm::InputTag pfCandidatesLabel_;
+
+    edm::EDGetTokenT<reco::PFCandidateCollection> m_thePFCandidateToken;
+};
+
+#endif  // HLTPFLightCandidateProducer_h_
+
@@ -17,6 +17,9 @@
 #include "DataFormats/MuonReco/interface/Muon.h"
 #include "DataFormats/RecoCandidate/interface/RecoChargedCandidate.h"
 
+#include "HLTrigger/JetMET/interface/RazorHemispheres.h"
+#include "HLTrigger/JetMET/interface/JetKinematics.h"
+
 namespace edm {
    class ConfigurationDescriptions;
 }
@@ -29,25 +32,33 @@ class HLTRHemisphere : public edm::EDFilter {
 
    public:
 
-
       explicit HLTRHemisphere(const edm::ParameterSet&);
       ~HLTRHemisphere();
       static void fillDescriptions(edm::ConfigurationDescriptions & descriptions);
       virtual bool filter(edm::Event&, const edm::EventSetup&);
 
+      typedef std::pair<math::XYZTLorentzVector, math::XYZTLorentzVector> HemispherePair;
+
+      // one pair of hemispheres for JETS plus each set of extra objects, in a single pass over the jet combinations
+      static void ComputeHemispheres(std::vector<HemispherePair>& hemispheres, const std::vector<math::XYZTLorentzVector>& JETS, const std::vector<std::vector<math::XYZTLorentzVector> >& extraJets);
+      // same, with a seeded iterative reassignment in O(n^2) instead of the exhaustive search
+      static void ComputeHemispheresApprox(std::vector<HemispherePair>& hemispheres, const std::vector<math::XYZTLorentzVector>& JETS, const std::vector<std::vector<math::XYZTLorentzVector> >& extraJets);
+
    private:
       edm::EDGetTokenT<edm::View<reco::Jet>> m_theJetToken;
+      edm::EDGetTokenT<JetKinematics> m_theJetKinematicsToken;
       edm::EDGetTokenT<std::vector<reco::RecoChargedCandidate>> m_theMuonToken;
       edm::InputTag inputTag_; // input tag identifying product
       edm::InputTag muonTag_;  // input tag for the muon objects 
+      edm::InputTag jetKinematicsLabel_; // optional JetKinematics, used instead of the jets
+      bool useJetKinematics_;
       bool doMuonCorrection_;   // do the muon corrections
       double muonEta_;         // maximum muon eta
       double min_Jet_Pt_;      // minimum jet pT threshold for collection
       double max_Eta_;         // maximum eta
       int max_NJ_;             // don't calculate R if event has more than NJ jets
       bool accNJJets_;         // accept or reject events with high NJ
-
-      void ComputeHemispheres(std::auto_ptr<std::vector<math::XYZTLorentzVector> >& hlist, const std::vector<math::XYZTLorentzVector>& JETS, std::vector<math::XYZTLorentzVector> *extraJets=0);
+      bool approxNJJets_;      // use the approximate hemispheres for events with high NJ
 };
 
 #endif //HLTRHemisphere_h
@@ -0,0 +1,62 @@
+#ifndef HLTRazorFilter_h
+#define HLTRazorFilter_h
+
+/** \class HLTRazorFilter
+ *
+ *  Razor selection in a single module: builds the megajets like
+ *  HLTRHemisphere and applies the MR / R cuts of HLTRFilter, without
+ *  the intermediate hemisphere collection.
+ *
+ */
+
+#include "FWCore/Framework/interface/Frameworkfwd.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/EDFilter.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/Utilities/interface/InputTag.h"
+
+#include "DataFormats/Common/interface/View.h"
+#include "DataFormats/JetReco/interface/Jet.h"
+#include "DataFormats/METReco/interface/CaloMET.h"
+#include "DataFormats/METReco/interface/CaloMETCollection.h"
+#include "DataFormats/RecoCandidate/interface/RecoChargedCandidate.h"
+
+namespace edm {
+   class ConfigurationDescriptions;
+}
+
+//
+// class declaration
+//
+
+class HLTRazorFilter : public edm::EDFilter {
+
+   public:
+
+      explicit HLTRazorFilter(const edm::ParameterSet&);
+      ~HLTRazorFilter();
+      static void fillDescriptions(edm::ConfigurationDescriptions & descriptions);
+      virtual bool filter(edm::Event&, const edm::EventSetup&);
+
+   private:
+      edm::EDGetTokenT<edm::View<reco::Jet>> m_theJetToken;
+      edm::EDGetTokenT<std::vector<reco::RecoChargedCandidate>> m_theMuonToken;
+      edm::EDGetTokenT<reco::CaloMETCollection> m_theMETToken;
+      edm::InputTag inputTag_;     // input tag identifying jets
+      edm::InputTag muonTag_;      // input tag for the muon objects
+      edm::InputTag inputMetTag_;  // input tag identifying MET product
+      bool doMuonCorrection_;      // do the muon corrections
+      double muonEta_;             // maximum muon eta
+      double min_Jet_Pt_;          // minimum jet pT threshold for collection
+      double max_Eta_;             // maximum eta
+      int max_NJ_;                 // don't calculate R if event has more than NJ jets
+      bool accNJJets_;             // accept or reject events with high NJ
+      bool approxNJJets_;          // use the approximate hemispheres for events with high NJ
+      double min_R_;               // minimum R vaule
+      double min_MR_;              // minimum MR vaule
+      double R_offset_;            // R offset for parameterized cut
+      double MR_offset_;           // MR offset for parameterized cut
+      double R_MR_cut_;            // Cut value for parameterized cut
+};
+
+#endif //HLTRazorFilter_h
@@ -0,0 +1,56 @@
+#ifndef HLTRazorVariablesFilter_h_
+#define HLTRazorVariablesFilter_h_
+
+/** \class HLTRazorVariablesFilter
+ *
+ *  \brief  This filters events based on MR and R produced by HLTRazorVariablesProducer
+ *
+ *  This filter can accept more than one razor working point. An event is kept
+ *  if, for at least one muon hypothesis, at least one working point satisfies:
+ *    - MR >= `minMR_[i]` ; and
+ *    - R >= `minR_[i]` ; and
+ *    - (R^2 - `R_offset_[i]`) * (MR - `MR_offset_[i]`) >= `R_MR_cut_[i]`
+ *  Events for which the hemispheres were not computed are accepted or rejected
+ *  according to `acceptNJ`, as in HLTRFilter.
+ *
+ */
+
+#include "FWCore/Framework/interface/EDFilter.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+
+#include "HLTrigger/JetMET/interface/RazorVariables.h"
+
+
+namespace edm {
+    class ConfigurationDescriptions;
+}
+
+// Class declaration
+class HLTRazorVariablesFilter : public edm::EDFilter {
+  public:
+    explicit HLTRazorVariablesFilter(const edm::ParameterSet & iConfig);
+    ~HLTRazorVariablesFilter();
+    static void fillDescriptions(edm::ConfigurationDescriptions & descriptions);
+    virtual bool filter(edm::Event & iEvent, const edm::EventSetup & iSetup);
+
+  private:
+    /// Input razor variables
+    edm::InputTag inputTag_;
+
+    /// Razor working points
+    std::vector<double> minR_;
+    std::vector<double> minMR_;
+    std::vector<double> R_offset_;
+    std::vector<double> MR_offset_;
+    std::vector<double> R_MR_cut_;
+
+    /// Accept or reject events with too many jets
+    bool accept_NJ_;
+
+    unsigned int nOrs_;  /// number of working points
+
+    edm::EDGetTokenT<RazorVariables> m_theInputToken;
+};
+
+#endif  // HLTRazorVariablesFilter_h_
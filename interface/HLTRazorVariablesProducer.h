@@ -0,0 +1,46 @@
+#ifndef HLTRazorVariablesProducer_h_
+#define HLTRazorVariablesProducer_h_
+
+/** \class HLTRazorVariablesProducer
+ *
+ *  \brief  This produces the razor variables MR and R for every muon hypothesis
+ *
+ *  MR and R are computed once per event from the RazorHemispheres product of
+ *  HLTRHemisphere and the MET, so that any number of razor working points can
+ *  be applied to them by HLTRazorVariablesFilter.
+ *
+ */
+
+#include "FWCore/Framework/interface/EDProducer.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/EventSetup.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+
+#include "DataFormats/METReco/interface/CaloMET.h"
+#include "DataFormats/METReco/interface/CaloMETCollection.h"
+
+#include "HLTrigger/JetMET/interface/RazorHemispheres.h"
+
+
+namespace edm {
+    class ConfigurationDescriptions;
+}
+
+// Class declaration
+class HLTRazorVariablesProducer : public edm::EDProducer {
+  public:
+    explicit HLTRazorVariablesProducer(const edm::ParameterSet & iConfig);
+    ~HLTRazorVariablesProducer();
+    static void fillDescriptions(edm::ConfigurationDescriptions & descriptions);
+    virtual void produce(edm::Event & iEvent, const edm::EventSetup & iSetup);
+
+  private:
+    /// Input hemispheres and MET
+    edm::InputTag inputTag_;
+    edm::InputTag inputMetTag_;
+
+    edm::EDGetTokenT<RazorHemispheres> m_theHemispheresToken;
+    edm::EDGetTokenT<reco::CaloMETCollection> m_theMETToken;
+};
+
+#endif  // HLTRazorVariablesProducer_h_
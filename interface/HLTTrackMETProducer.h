@@ -32,6 +32,7 @@
 #include "DataFormats/ParticleFlowReco/interface/PFRecTrackFwd.h"
 #include "DataFormats/ParticleFlowCandidate/interface/PFCandidate.h"
 #include "DataFormats/ParticleFlowCandidate/interface/PFCandidateFwd.h"
+#include "HLTrigger/JetMET/interface/PFLightCandidates.h"
 
 
 namespace edm {
@@ -86,10 +87,15 @@ class HLTTrackMETProducer : public edm::EDProducer {
     edm::InputTag pfRecTracksLabel_;
     edm::InputTag pfCandidatesLabel_;
 
+    /// Optional PFLightCandidates, used instead of the PFCandidate collection
+    edm::InputTag pfLightCandidatesLabel_;
+    bool usePFLightCandidates_;
+
     edm::EDGetTokenT<reco::JetView> m_theJetToken;
     edm::EDGetTokenT<reco::TrackCollection> m_theTrackToken;
     edm::EDGetTokenT<reco::PFRecTrackCollection> m_theRecTrackToken;
     edm::EDGetTokenT<reco::PFCandidateCollection> m_thePFCandidateToken;
+    edm::EDGetTokenT<PFLightCandidates> m_thePFLightCandidateToken;
 };
 
 #endif  // HLTTrackMETProducer_h_
@@ -0,0 +1,49 @@
+#ifndef HLTrigger_JetMET_HcalHPDEnergyMap_h
+#define HLTrigger_JetMET_HcalHPDEnergyMap_h
+
+/** \class HcalHPDEnergyMap
+ *
+ *  Energy of the HBHE rechits above threshold summed per HPD, in the four
+ *  HB/HE partitions; the HPDs are numbered by iphi, from 1 to 72, and the
+ *  four consecutive HPDs (4k-1 ... 4k+2, modulo 72) form RBX k+1.
+ *  Filled by HLTHPDFilter, or by HLTHcalHPDEnergyMapProducer to be shared.
+ *
+ */
+
+#include <utility>
+#include <vector>
+
+#include "DataFormats/HcalDetId/interface/HcalDetId.h"
+#include "DataFormats/HcalRecHit/interface/HcalRecHitCollections.h"
+
+
+class HcalHPDEnergyMap {
+public:
+  enum Partition { HBM = 0, HBP = 1, HEM = 2, HEP = 3 };
+
+  static const unsigned int kPartitions = 4;
+  // one more than the highest HPD number that hpdId() can return
+  static const unsigned int kHPDs = 74;
+
+  HcalHPDEnergyMap() : energy_(kPartitions * kHPDs, 0.f), threshold_(0.) { }
+
+  float energy(unsigned int partition, unsigned int hpd) const { return energy_[partition * kHPDs + hpd]; }
+
+  // the kHPDs energies of a partition, indexed by HPD number
+  const float* partition(unsigned int partition) const { return &energy_[partition * kHPDs]; }
+
+  // adds the energy of the hits above threshold to their HPD
+  void fill(const HBHERecHitCollection& hits, double threshold);
+
+  // threshold of the last fill()
+  double threshold() const { return threshold_; }
+
+  // partition and HPD number of a HB/HE channel
+  static std::pair<Partition, int> hpdId(HcalDetId id);
+
+private:
+  std::vector<float> energy_;
+  double threshold_;
+};
+
+#endif // HLTrigger_JetMET_HcalHPDEnergyMap_h
@@ -0,0 +1,109 @@
+#ifndef HLTrigger_JetMET_HcalNoiseRBXSelector_h
+#define HLTrigger_JetMET_HcalNoiseRBXSelector_h
+
+/** \class HcalNoiseRBXSelector
+ *
+ *  RBX noise selection shared by HLTHcalMETNoiseFilter, HLTHcalMETNoiseCleaner,
+ *  HLTHcalTowerNoiseCleaner and HLTHcalNoiseRBXSummaryProducer: it builds the
+ *  CommonHcalNoiseRBXData of each RBX and evaluates the noise criteria on it.
+ *
+ *  The thresholds are turned into a table of rules at construction, and the
+ *  rules are applied to all RBXs at once on per-quantity arrays, without
+ *  branches in the inner loops. The number of RBXs failing each criterion is
+ *  counted over the job and reported by report().
+ *
+ */
+
+#include <atomic>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "RecoMET/METAlgorithms/interface/HcalNoiseAlgo.h"
+#include "DataFormats/METReco/interface/HcalNoiseRBX.h"
+#include "HLTrigger/JetMET/interface/HcalNoiseRBXSummary.h"
+
+namespace edm {
+   class ParameterSetDescription;
+}
+
+class HcalNoiseRBXSelector {
+
+ public:
+  explicit HcalNoiseRBXSelector(const edm::ParameterSet&);
+  static void fillDescription(edm::ParameterSetDescription& desc);
+
+  // summaries of the RBXs, sorted by decreasing energy; as with the std::set used
+  // so far, an RBX with the same energy as a previous one is not kept.
+  // If maxRBXs is not negative, only the leading maxRBXs RBXs are summarized: they are
+  // ranked by their rec hit energy first, and the full noise data is built only for them
+  void summarize(const reco::HcalNoiseRBXCollection& rbxs, HcalNoiseRBXSummaryCollection& summaries, int maxRBXs = -1) const;
+
+  // the leading maxRBXs summaries (all if negative) built by another module, with the criteria
+  // evaluated again using the thresholds of this selector. Throws if the quantities were computed
+  // with rec hit energy or TS4TS5 settings different from those of this selector
+  void select(const HcalNoiseRBXSummaryCollection& summaries, HcalNoiseRBXSummaryCollection& selected, int maxRBXs = -1) const;
+
+  // bit masks of the criteria failed by each RBX, see HcalNoiseRBXSummary::Criterion;
+  // T is either CommonHcalNoiseRBXData or HcalNoiseRBXSummary
+  template <class T>
+  void criteria(const std::vector<T>& data, std::vector<unsigned int>& criteria) const;
+
+  // fingerprint of the settings the noise quantities depend on, as opposed to the thresholds of the criteria
+  unsigned int settings() const { return settings_; }
+
+  // number of RBXs evaluated, and of those failing a criterion, since the beginning of the job
+  unsigned long evaluated() const { return evaluated_.load(std::memory_order_relaxed); }
+  unsigned long failed(HcalNoiseRBXSummary::Criterion c) const { return failed_[c].load(std::memory_order_relaxed); }
+
+  // prints the counters to the MessageLogger, if any RBX was evaluated
+  void report(const std::string& module) const;
+
+  bool needEMFCoincidence() const { return needEMFCoincidence_; }
+  bool isNoise(const HcalNoiseRBXSummary& summary) const { return summary.isNoise(needEMFCoincidence_); }
+
+ private:
+  // quantities the rules apply to, see criteria()
+  enum Quantity { kRatio = 0, kHPDHits, kRBXHits, kHPDNoOtherHits, kZeros,
+                  kMinHighEHitTime, kMaxHighEHitTime, kFailTS4TS5, kRBXEMF, kNQuantities };
+  enum Comparison { kLess, kGreater, kGreaterEqual };
+
+  // an RBX above minRBXEnergy fails the criterion if "quantity comparison threshold" holds
+  struct Rule {
+    HcalNoiseRBXSummary::Criterion criterion;
+    Quantity quantity;
+    Comparison comparison;
+    double threshold;
+  };
+
+  void addRule(HcalNoiseRBXSummary::Criterion criterion, Quantity quantity, Comparison comparison, double threshold);
+
+  std::vector<Rule> rules_;
+  mutable std::atomic<unsigned long> evaluated_;
+  mutable std::atomic<unsigned long> failed_[HcalNoiseRBXSummary::kNCriteria];
+
+  bool needEMFCoincidence_;
+  double minRBXEnergy_;
+  double minRatio_;
+  double maxRatio_;
+  int minHPDHits_;
+  int minRBXHits_;
+  int minHPDNoOtherHits_;
+  int minZeros_;
+  double minHighEHitTime_;
+  double maxHighEHitTime_;
+  double maxRBXEMF_;
+
+  // imported from the RecoMET/METProducers/python/hcalnoiseinfoproducer_cfi
+  double minRecHitE_, minLowHitE_, minHighHitE_;
+
+  double TS4TS5EnergyThreshold_;
+  // non-const: CommonHcalNoiseRBXData takes them by reference
+  mutable std::vector<std::pair<double, double> > TS4TS5UpperCut_;
+  mutable std::vector<std::pair<double, double> > TS4TS5LowerCut_;
+
+  unsigned int settings_;
+};
+
+#endif // HLTrigger_JetMET_HcalNoiseRBXSelector_h
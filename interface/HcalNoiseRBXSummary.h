@@ -0,0 +1,110 @@
+#ifndef HLTrigger_JetMET_HcalNoiseRBXSummary_h
+#define HLTrigger_JetMET_HcalNoiseRBXSummary_h
+
+/** \class HcalNoiseRBXSummary
+ *
+ *  Noise quantities of one RBX, as computed by CommonHcalNoiseRBXData, and
+ *  the outcome of each noise criterion of HcalNoiseRBXSelector.
+ *  HLTHcalNoiseRBXSummaryProducer stores them as a vector sorted by
+ *  decreasing RBX energy, so that the HCAL noise filter and cleaners do
+ *  not need to recompute them; they evaluate the criteria again on the
+ *  stored quantities, with their own thresholds.
+ *
+ */
+
+#include <vector>
+
+#include "DataFormats/Common/interface/RefVector.h"
+#include "DataFormats/CaloTowers/interface/CaloTowerCollection.h"
+
+
+class HcalNoiseRBXSummary {
+public:
+  // noise criteria; the corresponding bit is set if the RBX is above minRBXEnergy and fails it
+  enum Criterion {
+    kMinRatio = 0,
+    kMaxRatio,
+    kHPDHits,
+    kRBXHits,
+    kHPDNoOtherHits,
+    kZeros,
+    kMinHighEHitTime,
+    kMaxHighEHitTime,
+    kTS4TS5,
+    kRBXEMF,
+    kNCriteria
+  };
+
+  // all criteria but the EMF one, i.e. the "passFilter" selection
+  static const unsigned int kFilterMask = (1U << kRBXEMF) - 1;
+
+  HcalNoiseRBXSummary() :
+    index_(0), energy_(0.), ratio_(0.), validRatio_(false),
+    numHPDHits_(0), numRBXHits_(0), numHPDNoOtherHits_(0), numZeros_(0),
+    minHighEHitTime_(0.), maxHighEHitTime_(0.), passTS4TS5_(true), RBXEMF_(0.),
+    criteria_(0), settings_(0)
+  { }
+
+  // from a CommonHcalNoiseRBXData of the RBX at position index in the HcalNoiseRBXCollection
+  template <class T>
+  HcalNoiseRBXSummary(unsigned int index, T const & data, unsigned int criteria, unsigned int settings) :
+    index_(index), energy_(data.energy()), ratio_(data.ratio()), validRatio_(data.validRatio()),
+    numHPDHits_(data.numHPDHits()), numRBXHits_(data.numRBXHits()),
+    numHPDNoOtherHits_(data.numHPDNoOtherHits()), numZeros_(data.numZeros()),
+    minHighEHitTime_(data.minHighEHitTime()), maxHighEHitTime_(data.maxHighEHitTime()),
+    passTS4TS5_(data.PassTS4TS5()), RBXEMF_(data.RBXEMF()),
+    criteria_(criteria), settings_(settings), rbxTowers_(data.rbxTowers())
+  { }
+
+  unsigned int index() const            { return index_; }
+  double energy() const                 { return energy_; }
+  double ratio() const                  { return ratio_; }
+  bool validRatio() const               { return validRatio_; }
+  int numHPDHits() const                { return numHPDHits_; }
+  int numRBXHits() const                { return numRBXHits_; }
+  int numHPDNoOtherHits() const         { return numHPDNoOtherHits_; }
+  int numZeros() const                  { return numZeros_; }
+  double minHighEHitTime() const        { return minHighEHitTime_; }
+  double maxHighEHitTime() const        { return maxHighEHitTime_; }
+  bool PassTS4TS5() const               { return passTS4TS5_; }
+  double RBXEMF() const                 { return RBXEMF_; }
+  edm::RefVector<CaloTowerCollection> const & rbxTowers() const { return rbxTowers_; }
+
+  // bit mask of the failed criteria, with the thresholds of the selector that set it
+  unsigned int criteria() const         { return criteria_; }
+  bool failed(Criterion c) const        { return criteria_ & (1U << c); }
+  void setCriteria(unsigned int criteria) { criteria_ = criteria; }
+
+  // fingerprint of the rec hit and TS4TS5 settings the quantities were computed with,
+  // see HcalNoiseRBXSelector::settings()
+  unsigned int settings() const         { return settings_; }
+
+  bool passFilter() const               { return !(criteria_ & kFilterMask); }
+  bool passEMF() const                  { return !failed(kRBXEMF); }
+
+  // the RBX is noisy, as defined by HLTHcalMETNoiseFilter
+  bool isNoise(bool needEMFCoincidence) const {
+    return needEMFCoincidence ? (!passEMF() && !passFilter()) : !passFilter();
+  }
+
+private:
+  unsigned int index_;
+  double energy_;
+  double ratio_;
+  bool validRatio_;
+  int numHPDHits_;
+  int numRBXHits_;
+  int numHPDNoOtherHits_;
+  int numZeros_;
+  double minHighEHitTime_;
+  double maxHighEHitTime_;
+  bool passTS4TS5_;
+  double RBXEMF_;
+  unsigned int criteria_;
+  unsigned int settings_;
+  edm::RefVector<CaloTowerCollection> rbxTowers_;
+};
+
+typedef std::vector<HcalNoiseRBXSummary> HcalNoiseRBXSummaryCollection;
+
+#endif // HLTrigger_JetMET_HcalNoiseRBXSummary_h
@@ -0,0 +1,63 @@
+#ifndef HLTrigger_JetMET_HtMhtTable_h
+#define HLTrigger_JetMET_HtMhtTable_h
+
+/** \class HtMhtTable
+ *
+ *  Jets within an |eta| acceptance, sorted by decreasing pt (or et), with the
+ *  cumulative HT and MHT components: HT and MHT for any jet pt threshold are
+ *  then found by a binary search, without going back to the jets.
+ *  Produced by HLTHtMhtTableProducer, and used by HLTHtMhtTableFilter.
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <vector>
+
+
+class HtMhtTable {
+public:
+  HtMhtTable() : usePt_(false), maxEta_(0.), ht_(1, 0.), mhx_(1, 0.), mhy_(1, 0.) { }
+  HtMhtTable(bool usePt, double maxEta) : usePt_(usePt), maxEta_(maxEta), ht_(1, 0.), mhx_(1, 0.), mhy_(1, 0.) { }
+
+  // acceptance of the jets in the table
+  bool usePt() const                    { return usePt_; }
+  double maxEta() const                 { return maxEta_; }
+
+  unsigned int size() const             { return pt_.size(); }
+  double pt(unsigned int i) const       { return pt_.at(i); }
+
+  // number of jets with pt > minPt
+  unsigned int nJets(double minPt) const {
+    return std::lower_bound(pt_.begin(), pt_.end(), minPt, std::greater<double>()) - pt_.begin();
+  }
+
+  // HT and MHT of the jets with pt > minPt
+  double ht(double minPt) const         { return ht_[nJets(minPt)]; }
+  double mhx(double minPt) const        { return mhx_[nJets(minPt)]; }
+  double mhy(double minPt) const        { return mhy_[nJets(minPt)]; }
+  double mht(double minPt) const {
+    unsigned int n = nJets(minPt);
+    return std::sqrt(mhx_[n]*mhx_[n] + mhy_[n]*mhy_[n]);
+  }
+
+  // the jets must be added by decreasing pt
+  void addJet(double pt, double px, double py) {
+    pt_.push_back(pt);
+    ht_.push_back(ht_.back() + pt);
+    mhx_.push_back(mhx_.back() - px);
+    mhy_.push_back(mhy_.back() - py);
+  }
+
+private:
+  bool usePt_;
+  double maxEta_;
+  std::vector<double> pt_;
+  // sums over the leading i jets at position i, starting from 0 for no jet
+  std::vector<double> ht_;
+  std::vector<double> mhx_;
+  std::vector<double> mhy_;
+};
+
+#endif // HLTrigger_JetMET_HtMhtTable_h
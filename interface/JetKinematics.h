@@ -0,0 +1,95 @@
+#ifndef HLTrigger_JetMET_JetKinematics_h
+#define HLTrigger_JetMET_JetKinematics_h
+
+/** \class JetKinematics
+ *
+ *  Kinematics of the jets of a collection, one array per quantity, as
+ *  returned by the reco::Jet accessors. index(i) is the position of jet i
+ *  in the input collection, to build a Ref to it; the jets keep the order
+ *  of the collection. Produced by HLTJetKinematicsProducer, which may keep
+ *  only the jets with pt > minPt(). The JetMET filters and producers that
+ *  have a jetKinematicsLabel parameter read it instead of the jets.
+ *
+ */
+
+#include <vector>
+
+
+class JetKinematics {
+public:
+  // the kinematics of one jet, with the same accessors as reco::Jet
+  class Element {
+  public:
+    Element(JetKinematics const & kin, unsigned int i) : kin_(kin), i_(i) { }
+    double pt() const                              { return kin_.pt_[i_]; }
+    double et() const                              { return kin_.et_[i_]; }
+    double eta() const                             { return kin_.eta_[i_]; }
+    double phi() const                             { return kin_.phi_[i_]; }
+    double px() const                              { return kin_.px_[i_]; }
+    double py() const                              { return kin_.py_[i_]; }
+    double pz() const                              { return kin_.pz_[i_]; }
+    double energy() const                          { return kin_.energy_[i_]; }
+    double mass() const                            { return kin_.mass_[i_]; }
+    unsigned int index() const                     { return kin_.index_[i_]; }
+  private:
+    JetKinematics const & kin_;
+    unsigned int i_;
+  };
+
+  JetKinematics() : minPt_(-1.) { }
+  explicit JetKinematics(double minPt) : minPt_(minPt) { }
+
+  // jets with pt <= minPt() are not stored, if it is not negative
+  double minPt() const                             { return minPt_; }
+  bool preselected() const                         { return minPt_ >= 0.; }
+
+  unsigned int size() const                        { return pt_.size(); }
+  bool empty() const                               { return pt_.empty(); }
+  void reserve(unsigned int n) {
+    pt_.reserve(n); et_.reserve(n); eta_.reserve(n); phi_.reserve(n);
+    px_.reserve(n); py_.reserve(n); pz_.reserve(n); energy_.reserve(n); mass_.reserve(n);
+    index_.reserve(n);
+  }
+
+  const std::vector<double>& pt() const            { return pt_; }
+  const std::vector<double>& et() const            { return et_; }
+  const std::vector<double>& eta() const           { return eta_; }
+  const std::vector<double>& phi() const           { return phi_; }
+  const std::vector<double>& px() const            { return px_; }
+  const std::vector<double>& py() const            { return py_; }
+  const std::vector<double>& pz() const            { return pz_; }
+  const std::vector<double>& energy() const        { return energy_; }
+  const std::vector<double>& mass() const          { return mass_; }
+  const std::vector<unsigned int>& index() const   { return index_; }
+
+  Element operator[](unsigned int i) const         { return Element(*this, i); }
+
+  template <class J>
+  void push_back(J const & jet, unsigned int index) {
+    pt_.push_back(jet.pt());
+    et_.push_back(jet.et());
+    eta_.push_back(jet.eta());
+    phi_.push_back(jet.phi());
+    px_.push_back(jet.px());
+    py_.push_back(jet.py());
+    pz_.push_back(jet.pz());
+    energy_.push_back(jet.energy());
+    mass_.push_back(jet.mass());
+    index_.push_back(index);
+  }
+
+private:
+  double minPt_;
+  std::vector<double> pt_;
+  std::vector<double> et_;
+  std::vector<double> eta_;
+  std::vector<double> phi_;
+  std::vector<double> px_;
+  std::vector<double> py_;
+  std::vector<double> pz_;
+  std::vector<double> energy_;
+  std::vector<double> mass_;
+  std::vector<unsigned int> index_;
+};
+
+#endif // HLTrigger_JetMET_JetKinematics_h
@@ -0,0 +1,62 @@
+#ifndef HLTrigger_JetMET_PFLightCandidates_h
+#define HLTrigger_JetMET_PFLightCandidates_h
+
+/** \class PFLightCandidates
+ *
+ *  The quantities of the PF candidates used by the HLT MET and MHT producers,
+ *  one array per quantity, in the order of the reco::PFCandidateCollection,
+ *  and the positions of the PF muons (|pdgId| == 13).
+ *  Produced by HLTPFLightCandidateProducer.
+ *
+ */
+
+#include <cstdlib>
+#include <vector>
+
+
+class PFLightCandidates {
+public:
+  PFLightCandidates() { }
+
+  unsigned int size() const                        { return pt_.size(); }
+  bool empty() const                               { return pt_.empty(); }
+  void reserve(unsigned int n) {
+    pt_.reserve(n); eta_.reserve(n); phi_.reserve(n); px_.reserve(n); py_.reserve(n);
+    charge_.reserve(n); pdgId_.reserve(n);
+  }
+
+  const std::vector<double>& pt() const            { return pt_; }
+  const std::vector<double>& eta() const           { return eta_; }
+  const std::vector<double>& phi() const           { return phi_; }
+  const std::vector<double>& px() const            { return px_; }
+  const std::vector<double>& py() const            { return py_; }
+  const std::vector<int>& charge() const           { return charge_; }
+  const std::vector<int>& pdgId() const            { return pdgId_; }
+
+  // positions of the PF muons
+  const std::vector<unsigned int>& muons() const   { return muons_; }
+
+  template <class C>
+  void push_back(C const & cand) {
+    if (std::abs(cand.pdgId()) == 13) muons_.push_back(pt_.size());
+    pt_.push_back(cand.pt());
+    eta_.push_back(cand.eta());
+    phi_.push_back(cand.phi());
+    px_.push_back(cand.px());
+    py_.push_back(cand.py());
+    charge_.push_back(cand.charge());
+    pdgId_.push_back(cand.pdgId());
+  }
+
+private:
+  std::vector<double> pt_;
+  std::vector<double> eta_;
+  std::vector<double> phi_;
+  std::vector<double> px_;
+  std::vector<double> py_;
+  std::vector<int> charge_;
+  std::vector<int> pdgId_;
+  std::vector<unsigned int> muons_;
+};
+
+#endif // HLTrigger_JetMET_PFLightCandidates_h
@@ -0,0 +1,67 @@
+#ifndef HLTrigger_JetMET_RazorHemispheres_h
+#define HLTrigger_JetMET_RazorHemispheres_h
+
+/** \class RazorHemispheres
+ *
+ *  Megajets built by HLTRHemisphere, with one pair of hemispheres per muon
+ *  hypothesis instead of the 2/5/10 size encoding of the vector product:
+ *  - no muon:  kMuonsAsMET
+ *  - 1 muon:   kMuonsAsMET, kLeadMuonAsJet
+ *  - 2 muons:  kMuonsAsMET, kLeadMuonAsJet, kSecondMuonAsJet, kMuonsAsJets
+ *
+ */
+
+#include <vector>
+
+#include "DataFormats/Math/interface/LorentzVector.h"
+
+
+class RazorHemispheres {
+public:
+  enum Hypothesis { kMuonsAsMET = 0, kLeadMuonAsJet = 1, kSecondMuonAsJet = 2, kMuonsAsJets = 3 };
+
+  // algorithm used to build the hemispheres
+  enum Algorithm { kNone = 0, kExact = 1, kApproximate = 2 };
+
+  RazorHemispheres() : algorithm_(kNone) { }
+
+  int algorithm() const                 { return algorithm_; }
+  void setAlgorithm(int algorithm)      { algorithm_ = algorithm; }
+
+  // number of hypotheses with hemispheres, 0 if they were not computed
+  unsigned int size() const             { return first_.size(); }
+  bool empty() const                    { return first_.empty(); }
+  bool has(Hypothesis h) const          { return (unsigned int) h < first_.size(); }
+
+  math::XYZTLorentzVector const & first(Hypothesis h) const  { return first_.at(h); }
+  math::XYZTLorentzVector const & second(Hypothesis h) const { return second_.at(h); }
+
+  // muons passing the selection, leading first
+  unsigned int nMuons() const                          { return muons_.size(); }
+  math::XYZTLorentzVector const & muon(unsigned int i) const { return muons_.at(i); }
+
+  // muons treated as jets in a given hypothesis, to be removed from the MET
+  std::vector<math::XYZTLorentzVector> muonsAsJets(Hypothesis h) const {
+    std::vector<math::XYZTLorentzVector> muons;
+    if (h == kLeadMuonAsJet   || h == kMuonsAsJets) muons.push_back(muons_.at(0));
+    if (h == kSecondMuonAsJet || h == kMuonsAsJets) muons.push_back(muons_.at(1));
+    return muons;
+  }
+
+  void addMuon(math::XYZTLorentzVector const & muon) {
+    muons_.push_back(muon);
+  }
+
+  void addHemispheres(math::XYZTLorentzVector const & first, math::XYZTLorentzVector const & second) {
+    first_.push_back(first);
+    second_.push_back(second);
+  }
+
+private:
+  int algorithm_;
+  std::vector<math::XYZTLorentzVector> muons_;
+  std::vector<math::XYZTLorentzVector> first_;
+  std::vector<math::XYZTLorentzVector> second_;
+};
+
+#endif // HLTrigger_JetMET_RazorHemispheres_h
@@ -0,0 +1,72 @@
+#ifndef HLTrigger_JetMET_RazorKinematics_h
+#define HLTrigger_JetMET_RazorKinematics_h
+
+/** \namespace razor
+ *
+ *  Razor variables (MR, R) computed on plain four-vectors, without
+ *  going through TLorentzVector / TVector3.
+ *
+ */
+
+#include <cmath>
+#include <limits>
+
+
+namespace razor {
+
+  struct FourVector {
+    double px;
+    double py;
+    double pz;
+    double e;
+
+    FourVector() : px(0.), py(0.), pz(0.), e(0.) { }
+    FourVector(double x, double y, double z, double t) : px(x), py(y), pz(z), e(t) { }
+
+    template <class T>
+    explicit FourVector(T const & p4) : px(p4.Px()), py(p4.Py()), pz(p4.Pz()), e(p4.E()) { }
+
+    double pt2() const { return px*px + py*py; }
+    double pt()  const { return std::sqrt(pt2()); }
+    double p()   const { return std::sqrt(pt2() + pz*pz); }
+  };
+
+  // MR of the two megajets, treated as massless, or -1 if the first megajet is empty;
+  // this is gamma * MR* as computed by HLTRFilter::CalcMR, which reduces to sqrt((|a|+|b|)^2 - (az+bz)^2)
+  inline
+  double calcMR(FourVector const & ja, FourVector const & jb) {
+    if (ja.pt() <= 0.1) return -1;
+
+    const double A  = ja.p();
+    const double B  = jb.p();
+    const double Z  = ja.pz + jb.pz;
+    const double TX = ja.px + jb.px;
+    const double TY = ja.py + jb.py;
+    const double ATBT  = TX*TX + TY*TY;
+    const double delta = jb.pt2() - ja.pt2();
+    const double MR2   = (A+B)*(A+B) - Z*Z;
+
+    // MR* or the boost are not defined: HLTRFilter::CalcMR returns a NaN as well
+    if (!(ATBT > 0.) || MR2 * ATBT < delta * delta)
+      return std::numeric_limits<double>::quiet_NaN();
+
+    return std::sqrt(MR2);
+  }
+
+  // R = MTR / MR, given the missing transverse momentum (metx, mety)
+  inline
+  double calcR(double MR, FourVector const & ja, FourVector const & jb, double metx, double mety) {
+    const double met = std::sqrt(metx*metx + mety*mety);
+    const double MTR = std::sqrt(0.5*(met*(ja.pt()+jb.pt()) - (metx*(ja.px+jb.px) + mety*(ja.py+jb.py))));
+    return float(MTR)/float(MR);
+  }
+
+  // razor working point, as used by HLTRFilter
+  inline
+  bool passes(double MR, double R, double minMR, double minR, double R2Offset, double MROffset, double RMRCut) {
+    return MR>=minMR && R>=minR && ( (R*R - R2Offset)*(MR-MROffset) )>=RMRCut;
+  }
+
+}
+
+#endif // HLTrigger_JetMET_RazorKinematics_h
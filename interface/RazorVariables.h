@@ -0,0 +1,42 @@
+#ifndef HLTrigger_JetMET_RazorVariables_h
+#define HLTrigger_JetMET_RazorVariables_h
+
+/** \class RazorVariables
+ *
+ *  MR and R for each muon hypothesis of a RazorHemispheres product,
+ *  in the same order (see RazorHemispheres::Hypothesis).
+ *
+ */
+
+#include <vector>
+
+#include "HLTrigger/JetMET/interface/RazorHemispheres.h"
+
+
+class RazorVariables {
+public:
+  RazorVariables() : algorithm_(RazorHemispheres::kNone) { }
+
+  // algorithm used to build the hemispheres, see RazorHemispheres::Algorithm
+  int algorithm() const                 { return algorithm_; }
+  void setAlgorithm(int algorithm)      { algorithm_ = algorithm; }
+
+  // number of hypotheses, 0 if the hemispheres were not computed
+  unsigned int size() const             { return mr_.size(); }
+  bool empty() const                    { return mr_.empty(); }
+
+  double MR(unsigned int h) const       { return mr_.at(h); }
+  double R(unsigned int h) const        { return r_.at(h); }
+
+  void add(double MR, double R) {
+    mr_.push_back(MR);
+    r_.push_back(R);
+  }
+
+private:
+  int algorithm_;
+  std::vector<double> mr_;
+  std::vector<double> r_;
+};
+
+#endif // HLTrigger_JetMET_RazorVariables_h
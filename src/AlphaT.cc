@@ -1,5 +1,14 @@
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <utility>
+
 #include "HLTrigger/JetMET/interface/AlphaT.h"
 
+const unsigned int AlphaT::max_jets_;
+
 double AlphaT::value_(std::vector<bool> * jet_sign) const {
 
   // Clear pseudo-jet container
@@ -13,7 +22,7 @@ double AlphaT::value_(std::vector<bool> * jet_sign) const {
     // empty jet collection, return AlphaT = 0
     return 0.;
 
-  if (et_.size() > (unsigned int) std::numeric_limits<unsigned int>::digits)
+  if (et_.size() > max_jets_)
     // too many jets, return AlphaT = a very large number
     return std::numeric_limits<double>::max();
 
@@ -23,6 +32,121 @@ double AlphaT::value_(std::vector<bool> * jet_sign) const {
   const double sum_py = std::accumulate( py_.begin(), py_.end(), 0. );
 
   // Minimum Delta Et for two pseudo-jets
+  if (jet_sign || !min_delta_sum_et_valid_) {
+    if (et_.size() <= max_brute_force_jets_)
+      min_delta_sum_et_ = min_delta_sum_et_brute_force_(sum_et, jet_sign);
+    else
+      min_delta_sum_et_ = min_delta_sum_et_meet_in_the_middle_(sum_et, jet_sign);
+    min_delta_sum_et_valid_ = true;
+  }
+  const double min_delta_sum_et = min_delta_sum_et_;
+
+  // Alpha_T
+  return (0.5 * (sum_et - min_delta_sum_et) / sqrt( sum_et*sum_et - (sum_px*sum_px+sum_py*sum_py) ));
+}
+
+bool AlphaT::passes(double threshold) const {
+
+  if (et_.empty() || et_.size() > max_jets_)
+    return value() > threshold;
+
+  // Momentum sums in transverse plane
+  const double sum_et = std::accumulate( et_.begin(), et_.end(), 0. );
+  const double sum_px = std::accumulate( px_.begin(), px_.end(), 0. );
+  const double sum_py = std::accumulate( py_.begin(), py_.end(), 0. );
+  const double denominator = sqrt( sum_et*sum_et - (sum_px*sum_px+sum_py*sum_py) );
+
+  if (!(denominator > 0.))
+    // degenerate configuration, let value() deal with it
+    return value() > threshold;
+
+  // AlphaT > threshold if and only if some partition has |Delta HT| < target
+  const double target = sum_et - 2. * threshold * denominator;
+
+  // the hardest jet cannot be balanced by more than the sum of all the others
+  const double max_et = *std::max_element( et_.begin(), et_.end() );
+  if (target <= std::max(0., 2. * max_et - sum_et))
+    return false;
+
+  // any partition has |Delta HT| <= sum_et
+  if (target > sum_et)
+    return true;
+
+  if (min_delta_sum_et_valid_)
+    return min_delta_sum_et_ < target;
+
+  // a good partition is usually found by the greedy algorithm
+  if (min_delta_sum_et_greedy_() < target)
+    return true;
+
+  const double min_delta_sum_et = (et_.size() <= max_brute_force_jets_) ?
+    min_delta_sum_et_brute_force_(sum_et, 0, target) :
+    min_delta_sum_et_meet_in_the_middle_(sum_et, 0, target);
+  if (min_delta_sum_et < target)
+    return true;
+
+  // the search went through all the partitions, so this is the minimum
+  min_delta_sum_et_ = min_delta_sum_et;
+  min_delta_sum_et_valid_ = true;
+  return false;
+}
+
+double AlphaT::min_delta_sum_et_greedy_(void) const {
+
+  // assign the jets, from the hardest to the softest, to the pseudo-jet with the smaller Et
+  std::vector<double> & et = sorted_et_;
+  et.assign(et_.begin(), et_.end());
+  std::sort(et.begin(), et.end(), std::greater<double>());
+
+  double delta_sum_et = 0.;
+  for (unsigned int j = 0; j < et.size(); ++j)
+    delta_sum_et = std::abs(delta_sum_et - et[j]);
+
+  return delta_sum_et;
+}
+
+void AlphaT::update_(void) {
+
+  if (et_.size() > max_brute_force_jets_) {
+    // too many jets, release the reachable partitions and fall back to the meet-in-the-middle algorithm
+    std::vector<double>().swap(delta_sum_et_);
+    min_delta_sum_et_valid_ = false;
+    return;
+  }
+
+  if (et_.size() > 1 && delta_sum_et_.size() == (1U << (et_.size() - 2))) {
+    // the partitions of the previous jets are up to date, just add the new one
+    extend_(et_.back());
+    min_delta_sum_et_valid_ = true;
+    return;
+  }
+
+  // (re)build the partitions from scratch
+  delta_sum_et_.assign(1, et_.front());
+  min_delta_sum_et_ = et_.front();
+  for (unsigned int j = 1; j < et_.size(); ++j)
+    extend_(et_[j]);
+  min_delta_sum_et_valid_ = true;
+}
+
+void AlphaT::extend_(double et) {
+
+  // each partition |d| of the previous jets gives two partitions with the new jet: d + et and |d - et|
+  const unsigned int size = delta_sum_et_.size();
+  delta_sum_et_.resize(2 * size);
+
+  double min_delta_sum_et = std::numeric_limits<double>::max();
+  for (unsigned int i = 0; i < size; ++i) {
+    const double delta_sum_et = delta_sum_et_[i];
+    delta_sum_et_[i]        = delta_sum_et + et;
+    delta_sum_et_[size + i] = std::abs(delta_sum_et - et);
+    min_delta_sum_et = std::min(min_delta_sum_et, delta_sum_et_[size + i]);
+  }
+  min_delta_sum_et_ = min_delta_sum_et;
+}
+
+double AlphaT::min_delta_sum_et_brute_force_(double sum_et, std::vector<bool> * jet_sign, double target) const {
+
   double min_delta_sum_et = sum_et;
 
   for (unsigned int i = 0; i < (1U << (et_.size() - 1)); i++) { //@@ iterate through different combinations
@@ -40,9 +164,76 @@ double AlphaT::value_(std::vector<bool> * jet_sign) const {
         for (unsigned int j = 0; j < et_.size(); ++j)
           (*jet_sign)[j] = ((i & (1U << j)) == 0);
       }
+      if (min_delta_sum_et < target)
+        break;
     }
   }
 
-  // Alpha_T
-  return (0.5 * (sum_et - min_delta_sum_et) / sqrt( sum_et*sum_et - (sum_px*sum_px+sum_py*sum_py) ));  
+  return min_delta_sum_et;
+}
+
+double AlphaT::min_delta_sum_et_meet_in_the_middle_(double sum_et, std::vector<bool> * jet_sign, double target) const {
+
+  // Split the jets in two halves: the first n_low jets are enumerated exhaustively, the remaining
+  // n_high ones are enumerated once and sorted, so that the best complement for each partition of
+  // the first half can be found with a binary search. The sign of the last jet is kept fixed, as in
+  // the brute force algorithm, so the second half has only 2^(n_high-1) distinct partitions.
+  typedef std::pair<double, unsigned long long> signed_sum;
+
+  const unsigned int n_jets = et_.size();
+  const unsigned int n_low  = n_jets / 2;
+  const unsigned int n_high = n_jets - n_low;
+
+  // signed Et sums of the first half, built incrementally: bit j set means jet j is subtracted
+  std::vector<double> & low = low_;
+  low.resize(1ULL << n_low);
+  low[0] = 0.;
+  for (unsigned int j = 0; j < n_low; ++j)
+    for (unsigned long long i = 0; i < (1ULL << j); ++i) {
+      low[i | (1ULL << j)] = low[i] - et_[j];
+      low[i] += et_[j];
+    }
+
+  // signed Et sums of the second half, with the last jet always added
+  std::vector<signed_sum> & high = high_;
+  high.resize(1ULL << (n_high - 1));
+  high[0] = signed_sum(et_[n_jets - 1], 0ULL);
+  for (unsigned int j = 0; j < n_high - 1; ++j)
+    for (unsigned long long i = 0; i < (1ULL << j); ++i) {
+      high[i | (1ULL << j)] = signed_sum(high[i].first - et_[n_low + j], high[i].second | (1ULL << (n_low + j)));
+      high[i].first += et_[n_low + j];
+    }
+  std::sort(high.begin(), high.end());
+
+  double min_delta_sum_et = sum_et;
+  unsigned long long min_mask = 0;
+
+  for (unsigned long long i = 0; i < low.size(); ++i) {
+    // look for the second half sum closest to -low[i]
+    std::vector<signed_sum>::const_iterator it = std::lower_bound(high.begin(), high.end(), signed_sum(-low[i], 0ULL));
+    if (it != high.end()) {
+      const double delta_sum_et = std::abs(low[i] + it->first);
+      if (delta_sum_et < min_delta_sum_et) {
+        min_delta_sum_et = delta_sum_et;
+        min_mask = i | it->second;
+      }
+    }
+    if (it != high.begin()) {
+      --it;
+      const double delta_sum_et = std::abs(low[i] + it->first);
+      if (delta_sum_et < min_delta_sum_et) {
+        min_delta_sum_et = delta_sum_et;
+        min_mask = i | it->second;
+      }
+    }
+    if (min_delta_sum_et < target)
+      break;
+  }
+
+  if (jet_sign) {
+    for (unsigned int j = 0; j < n_jets; ++j)
+      (*jet_sign)[j] = ((min_mask & (1ULL << j)) == 0);
+  }
+
+  return min_delta_sum_et;
 }
@@ -14,6 +14,7 @@
 #include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
 #include "FWCore/Utilities/interface/InputTag.h"
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/Utilities/interface/Exception.h"
 #include "DataFormats/Math/interface/deltaPhi.h"
 #include "DataFormats/Common/interface/Handle.h"
 #include "HLTrigger/JetMET/interface/HLTAlphaTFilter.h"
@@ -29,6 +30,8 @@ HLTAlphaTFilter<T>::HLTAlphaTFilter(const edm::ParameterSet& iConfig) : HLTFilte
 {
   inputJetTag_         = iConfig.getParameter< edm::InputTag > ("inputJetTag");
   inputJetTagFastJet_  = iConfig.getParameter< edm::InputTag > ("inputJetTagFastJet");
+  jetKinematicsLabel_  = iConfig.getParameter< edm::InputTag > ("jetKinematicsLabel");
+  useJetKinematics_    = jetKinematicsLabel_.label() != "";
   minPtJet_            = iConfig.getParameter<std::vector<double> > ("minPtJet");
   etaJet_              = iConfig.getParameter<std::vector<double> > ("etaJet");
   maxNJets_            = iConfig.getParameter<unsigned int> ("maxNJets");
@@ -47,6 +50,7 @@ HLTAlphaTFilter<T>::HLTAlphaTFilter(const edm::ParameterSet& iConfig) : HLTFilte
   //register your products
   m_theRecoJetToken = consumes<std::vector<T>>(inputJetTag_);
   m_theFastJetToken = consumes<std::vector<T>>(inputJetTagFastJet_);
+  if (useJetKinematics_) m_theJetKinematicsToken = consumes<JetKinematics>(jetKinematicsLabel_);
 }
 
 template<typename T>
@@ -58,6 +62,7 @@ void HLTAlphaTFilter<T>::fillDescriptions(edm::ConfigurationDescriptions& descri
   makeHLTFilterDescription(desc);
   desc.add<edm::InputTag>("inputJetTag",edm::InputTag("hltMCJetCorJetIcone5HF07"));
   desc.add<edm::InputTag>("inputJetTagFastJet",edm::InputTag("hltMCJetCorJetIcone5HF07"));
+  desc.add<edm::InputTag>("jetKinematicsLabel",edm::InputTag(""));
 
   {
     std::vector<double> temp1;
@@ -74,7 +79,7 @@ void HLTAlphaTFilter<T>::fillDescriptions(edm::ConfigurationDescriptions& descri
     temp1.push_back(9999.0);
     desc.add<std::vector<double> >("etaJet",temp1);
   }
-  desc.add<unsigned int>("maxNJets",32);
+  desc.add<unsigned int>("maxNJets",AlphaT::max_jets_);
   desc.add<double>("minHt",0.0);
   desc.add<double>("minAlphaT",0.0);
   desc.add<int>("triggerType",trigger::TriggerJet);
@@ -83,6 +88,67 @@ void HLTAlphaTFilter<T>::fillDescriptions(edm::ConfigurationDescriptions& descri
 
 
 
+// ------------ add the jets if they pass the HT and AlphaT cuts  ------------
+template<typename T>
+template<class C, class P>
+int HLTAlphaTFilter<T>::addJets(C const & jets, unsigned int nJets, P position, edm::Handle<std::vector<T>> const & recojets, edm::Handle<std::vector<T>> const & recojetsFastJet, trigger::TriggerFilterObjectWithRefs & filterproduct) const
+{
+  typedef edm::Ref<std::vector<T>> TRef;
+
+  TRef ref;
+
+  int n(0), flag(0);
+  double htFast = 0.;
+  unsigned int njets(0);
+
+  // Accumulate the Lorentz Jets for the AlphaT calcualtion, one jet at a time
+  AlphaT alphaT;
+
+  for (unsigned int i = 0; i < nJets; ++i) {
+    if( flag == 1) break;
+    // Do Some Jet selection!
+    if( std::abs(jets[i].eta()) > etaJet_.at(0) ) continue;
+    if( jets[i].et() < minPtJet_.at(0) ) continue;
+    njets++;
+
+    if (njets > maxNJets_) //AlphaT is not computed above AlphaT::max_jets_ jets - if too many jets passing pt / eta cuts, just accept the event
+      flag = 1;
+
+    else {
+
+      // the jet of the second collection at the same position
+      const T & jetFast = (*recojetsFastJet)[position(i)];
+      if( std::abs(jetFast.eta()) < etaJet_.at(1) ){
+        if( jetFast.et() > minPtJet_.at(1) ) {
+          // Add to HT
+          htFast += jetFast.et();
+        }
+      }
+
+      // Add to AlphaT
+      LorentzV JetLVec(jets[i].pt(),jets[i].eta(),jets[i].phi(),jets[i].mass());
+      alphaT.push_back( JetLVec );
+      if(htFast > minHt_ && alphaT.passes(minAlphaT_)){
+        // set flat to one so that we don't carry on looping though the jets
+        flag = 1;
+      }
+    }
+
+  }
+
+  if (flag==1) {
+    for (unsigned int i = 0; i < nJets; ++i) {
+      if (jets[i].et() > minPtJet_.at(0)) {
+        ref = TRef(recojets,position(i));
+        filterproduct.addObject(triggerType_,ref);
+        n++;
+      }
+    }
+  }
+
+  return n;
+}
+
 // ------------ method called to produce the data  ------------
 template<typename T>
 bool HLTAlphaTFilter<T>::hltFilter(edm::Event& iEvent, const edm::EventSetup& iSetup, trigger::TriggerFilterObjectWithRefs & filterproduct) const
@@ -94,82 +160,39 @@ bool HLTAlphaTFilter<T>::hltFilter(edm::Event& iEvent, const edm::EventSetup& iS
   using namespace trigger;
 
   typedef vector<T> TCollection;
-  typedef Ref<TCollection> TRef;
 
   // The filter object
   if (saveTags()) filterproduct.addCollectionTag(inputJetTag_);
 
-  TRef ref;
   // Get the Candidates
   Handle<TCollection> recojets;
   iEvent.getByToken(m_theRecoJetToken,recojets);
 
   // We have to also look at the L1 FastJet Corrections, at the same time we look at our other jets.
   // We calcualte our HT from the FastJet collection and AlphaT from the standard collection.
-  CaloJetRef ref_FastJet;
   // Get the Candidates
   Handle<TCollection> recojetsFastJet;
   iEvent.getByToken(m_theFastJetToken,recojetsFastJet);
 
 
 
-
-
   // look at all candidates,  check cuts and add to filter object
-  int n(0), flag(0);
-  double htFast = 0.;
-  unsigned int njets(0);
+  int n(0);
 
   if(recojets->size() > 1){
     // events with at least two jets, needed for alphaT
-    // Make a vector of Lorentz Jets for the AlphaT calcualtion
-    std::vector<LorentzV> jets;
-    typename TCollection::const_iterator ijet     = recojets->begin();
-    typename TCollection::const_iterator ijetFast = recojetsFastJet->begin();
-    typename TCollection::const_iterator jjet     = recojets->end();
-
-
-
-    for( ; ijet != jjet; ijet++, ijetFast++ ) {
-      if( flag == 1) break;
-      // Do Some Jet selection!
-      if( std::abs(ijet->eta()) > etaJet_.at(0) ) continue;
-      if( ijet->et() < minPtJet_.at(0) ) continue;
-      njets++;
-
-      if (njets > maxNJets_) //to keep timing reasonable - if too many jets passing pt / eta cuts, just accept the event
-	flag = 1;
-
-      else {
-
-	if( std::abs(ijetFast->eta()) < etaJet_.at(1) ){
-	  if( ijetFast->et() > minPtJet_.at(1) ) {
-	    // Add to HT
-	    htFast += ijetFast->et();
-	  }
-	}
-
-	// Add to JetVector
-	LorentzV JetLVec(ijet->pt(),ijet->eta(),ijet->phi(),ijet->mass());
-	jets.push_back( JetLVec );
-	double aT = AlphaT(jets).value();
-	if(htFast > minHt_ && aT > minAlphaT_){
-	  // set flat to one so that we don't carry on looping though the jets
-	  flag = 1;
-	}
-      }
-
-    }
-
-    if (flag==1) {
-      for (typename TCollection::const_iterator recojet = recojets->begin(); recojet!=jjet; recojet++) {
-	if (recojet->et() > minPtJet_.at(0)) {
-	  ref = TRef(recojets,distance(recojets->begin(),recojet));
-	  filterproduct.addObject(triggerType_,ref);
-	  n++;
-	}
-      }
+    if (useJetKinematics_) {
+      Handle<JetKinematics> jetKinematics;
+      iEvent.getByToken(m_theJetKinematicsToken,jetKinematics);
+      const JetKinematics & kin = *jetKinematics;
+      // the jets are selected on et, which a pt preselection does not bound
+      if (kin.preselected())
+        throw cms::Exception("Configuration") << "HLTAlphaTFilter: JetKinematics " << jetKinematicsLabel_
+                                              << " only has the jets with pt > " << kin.minPt() << ".\n";
+      n = addJets(kin, kin.size(), [&kin](unsigned int i) { return kin.index()[i]; }, recojets, recojetsFastJet, filterproduct);
     }
+    else
+      n = addJets(*recojets, recojets->size(), [](unsigned int i) { return i; }, recojets, recojetsFastJet, filterproduct);
   }// events with at least two jet
 
   // filter decision
@@ -18,6 +18,7 @@
 #include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 #include "FWCore/Utilities/interface/InputTag.h"
+#include "FWCore/Utilities/interface/Exception.h"
 
 #include<typeinfo>
 
@@ -30,9 +31,12 @@ HLTDiJetAveFilter<T>::HLTDiJetAveFilter(const edm::ParameterSet& iConfig) : HLTF
   minPtAve_    (iConfig.template getParameter<double> ("minPtAve")),
   minPtJet3_   (iConfig.template getParameter<double> ("minPtJet3")),
   minDphi_     (iConfig.template getParameter<double> ("minDphi")),
-  triggerType_ (iConfig.template getParameter<int> ("triggerType"))
+  triggerType_ (iConfig.template getParameter<int> ("triggerType")),
+  jetKinematicsLabel_ (iConfig.template getParameter< edm::InputTag > ("jetKinematicsLabel")),
+  useJetKinematics_   (jetKinematicsLabel_.label() != "")
 {
   m_theJetToken = consumes<std::vector<T>>(inputJetTag_);
+  if (useJetKinematics_) m_theJetKinematicsToken = consumes<JetKinematics>(jetKinematicsLabel_);
   LogDebug("") << "HLTDiJetAveFilter: Input/minPtAve/minPtJet3/minDphi/triggerType : "
 	       << inputJetTag_.encode() << " "
 	       << minPtAve_ << " "
@@ -54,9 +58,56 @@ HLTDiJetAveFilter<T>::fillDescriptions(edm::ConfigurationDescriptions& descripti
   desc.add<double>("minPtJet3",99999.0);
   desc.add<double>("minDphi",-1.0);
   desc.add<int>("triggerType",trigger::TriggerJet);
+  desc.add<edm::InputTag>("jetKinematicsLabel",edm::InputTag(""));
   descriptions.add(std::string("hlt")+std::string(typeid(HLTDiJetAveFilter<T>).name()),desc);
 }
 
+// ------------ add the two leading jets if they pass the cuts  ------------
+template<typename T>
+template<class C, class P>
+int
+HLTDiJetAveFilter<T>::addDiJet(C const & jets, unsigned int nJets, P position, edm::Handle<std::vector<T>> const & objects, trigger::TriggerFilterObjectWithRefs & filterproduct) const
+{
+  typedef edm::Ref<std::vector<T>> TRef;
+
+  int n(0);
+
+  double ptjet1=0., ptjet2=0.,ptjet3=0.;
+  double phijet1=0.,phijet2=0;
+
+  unsigned int nmax=1;
+  if (nJets > 2) nmax=2;
+
+  TRef JetRef1,JetRef2;
+
+  for (unsigned int i = 0; i <= nmax; ++i) {
+    if(i==0) {
+      ptjet1 = jets[i].pt();
+      phijet1 = jets[i].phi();
+      JetRef1 = TRef(objects,position(i));
+    }
+    if(i==1) {
+      ptjet2 = jets[i].pt();
+      phijet2 = jets[i].phi();
+      JetRef2 = TRef(objects,position(i));
+    }
+    if(i==2) {
+      ptjet3 = jets[i].pt();
+    }
+  }
+
+  double PtAve=(ptjet1 + ptjet2) / 2.;
+  double Dphi = std::abs(reco::deltaPhi(phijet1,phijet2));
+
+  if( PtAve>minPtAve_ && ptjet3<minPtJet3_ && Dphi>minDphi_){
+    filterproduct.addObject(triggerType_,JetRef1);
+    filterproduct.addObject(triggerType_,JetRef2);
+    ++n;
+  }
+
+  return n;
+}
+
 // ------------ method called to produce the data  ------------
 template<typename T>
 bool
@@ -68,7 +119,6 @@ HLTDiJetAveFilter<T>::hltFilter(edm::Event& iEvent, const edm::EventSetup& iSetu
   using namespace trigger;
 
   typedef vector<T> TCollection;
-  typedef Ref<TCollection> TRef;
 
   // The filter object
   if (saveTags()) filterproduct.addCollectionTag(inputJetTag_);
@@ -82,43 +132,18 @@ HLTDiJetAveFilter<T>::hltFilter(edm::Event& iEvent, const edm::EventSetup& iSetu
 
   if(objects->size() > 1){
     // events with two or more jets
-
-    double ptjet1=0., ptjet2=0.,ptjet3=0.;
-    double phijet1=0.,phijet2=0;
-    int countjets =0;
-
-    int nmax=1;
-    if (objects->size() > 2) nmax=2;
-
-    TRef JetRef1,JetRef2;
-
-    typename TCollection::const_iterator i ( objects->begin() );
-    for (; i<=(objects->begin()+nmax); i++) {
-      if(countjets==0) {
-	ptjet1 = i->pt();
-	phijet1 = i->phi();
-	JetRef1 = TRef(objects,distance(objects->begin(),i));
-      }
-      if(countjets==1) {
-	ptjet2 = i->pt();
-	phijet2 = i->phi();
-	JetRef2 = TRef(objects,distance(objects->begin(),i));
-      }
-      if(countjets==2) {
-	ptjet3 = i->pt();
-      }
-      ++countjets;
+    if (useJetKinematics_) {
+      Handle<JetKinematics> jetKinematics;
+      iEvent.getByToken (m_theJetKinematicsToken,jetKinematics);
+      const JetKinematics & kin = *jetKinematics;
+      // the three leading jets are used whatever their pt
+      if (kin.preselected())
+        throw cms::Exception("Configuration") << "HLTDiJetAveFilter: JetKinematics " << jetKinematicsLabel_
+                                              << " only has the jets with pt > " << kin.minPt() << ".\n";
+      n = addDiJet(kin, kin.size(), [&kin](unsigned int i) { return kin.index()[i]; }, objects, filterproduct);
     }
-
-    double PtAve=(ptjet1 + ptjet2) / 2.;
-    double Dphi = std::abs(deltaPhi(phijet1,phijet2));
-
-    if( PtAve>minPtAve_ && ptjet3<minPtJet3_ && Dphi>minDphi_){
-      filterproduct.addObject(triggerType_,JetRef1);
-      filterproduct.addObject(triggerType_,JetRef2);
-      ++n;
-    }
-
+    else
+      n = addDiJet(*objects, objects->size(), [](unsigned int i) { return i; }, objects, filterproduct);
   } // events with two or more jets
 
 
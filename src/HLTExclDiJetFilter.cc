@@ -35,7 +35,7 @@ HLTExclDiJetFilter<T>::HLTExclDiJetFilter(const edm::ParameterSet& iConfig) :
   triggerType_ (iConfig.template getParameter<int> ("triggerType"))
 {
   m_theJetToken = consumes<std::vector<T>>(inputJetTag_);
-  m_theCaloTowerCollectionToken = consumes<CaloTowerCollection>(caloTowerTag_);
+  m_theCaloTowerCollectionToken = consumes<edm::View<CaloTower> >(caloTowerTag_);
   LogDebug("") << "HLTExclDiJetFilter: Input/minPtJet/minHFe/HF_OR/triggerType : "
 	       << inputJetTag_.encode() << " "
 	       << caloTowerTag_.encode() << " "
@@ -133,10 +133,10 @@ HLTExclDiJetFilter<T>::hltFilter(edm::Event& iEvent, const edm::EventSetup& iSet
      double ehfp(0.);
      double ehfm(0.);
 
-     Handle<CaloTowerCollection> o;
+     Handle<edm::View<CaloTower> > o;
      iEvent.getByToken(m_theCaloTowerCollectionToken,o);
 //     if( o.isValid()) {
-      for( CaloTowerCollection::const_iterator cc = o->begin(); cc != o->end(); ++cc ) {
+      for( edm::View<CaloTower>::const_iterator cc = o->begin(); cc != o->end(); ++cc ) {
        if(std::abs(cc->ieta())>28 && cc->energy()<4.0) continue;
         if(cc->ieta()>28)  ehfp+=cc->energy();  // HF+ energy
         if(cc->ieta()<-28) ehfm+=cc->energy();  // HF- energy
@@ -5,6 +5,7 @@
  */
 
 #include "HLTrigger/JetMET/interface/HLTHPDFilter.h"
+#include "HLTrigger/JetMET/interface/HcalHPDEnergyMap.h"
 
 #include <math.h>
 
@@ -27,60 +28,20 @@
 #include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
 #include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
 #include "FWCore/Utilities/interface/InputTag.h"
-
-namespace {
-  enum Partition {HBM=0, HBP=1, HEM=2, HEP=3}; 
-  std::pair<Partition,int> hpdId (HcalDetId fId) {
-    int hpd = fId.iphi ();
-    Partition partition = HBM;
-    if (fId.subdet() == HcalBarrel) {
-      partition = fId.ieta() > 0 ? HBP : HBM;
-    }
-    else if (fId.subdet() == HcalEndcap) {
-      partition = fId.ieta() > 0 ? HEP : HEM;
-      if ((fId.iphi ()-1) % 4 < 2) { // 1,2 
-	switch (fId.ieta()) { // 1->2
-	case 22:
-	case 24:
-	case 26:
-	case 28:
-	  hpd = +1;
-	  break;
-	case 29:
-	  if (fId.depth () == 1 || fId.depth () == 3) hpd += 1;
-	  break;
-	default:
-	  break;
-	}
-      }
-      else { // 3,4
-	switch (fId.ieta()) { // 3->4
-	case 21:
-	case 23:
-	case 25:
-	case 27:
-	  hpd += 1;
-	  break;
-	case 29:
-	  if (fId.depth () == 2) hpd += 1;
-	  break;
-	default:
-	  break;
-	}
-      }
-    }
-    return std::pair<Partition,int> (partition, hpd);
-  }
-}
+#include "FWCore/Utilities/interface/Exception.h"
 
 HLTHPDFilter::HLTHPDFilter(const edm::ParameterSet& iConfig) :
      mInputTag (iConfig.getParameter <edm::InputTag> ("inputTag")),
+     mHPDEnergyMapTag (iConfig.getParameter <edm::InputTag> ("hpdEnergyMap")),
      mEnergyThreshold (iConfig.getParameter <double> ("energy")),
      mHPDSpikeEnergyThreshold (iConfig.getParameter <double> ("hpdSpikeEnergy")),
      mHPDSpikeIsolationEnergyThreshold (iConfig.getParameter <double> ("hpdSpikeIsolationEnergy")),
      mRBXSpikeEnergyThreshold (iConfig.getParameter <double> ("rbxSpikeEnergy")),
      mRBXSpikeUnbalanceThreshold (iConfig.getParameter <double> ("rbxSpikeUnbalance"))
 {
+  mUseHPDEnergyMap = (mHPDEnergyMapTag.label() != "");
+  if (mUseHPDEnergyMap) m_theHPDEnergyMapToken = consumes<HcalHPDEnergyMap>(mHPDEnergyMapTag);
+  // the rec hits are also used if the map is missing
   m_theRecHitCollectionToken = consumes<HBHERecHitCollection>(mInputTag);
 }
 
@@ -90,6 +51,7 @@ void
 HLTHPDFilter::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
   edm::ParameterSetDescription desc;
   desc.add<edm::InputTag>("inputTag",edm::InputTag("hltHbhereco"));
+  desc.add<edm::InputTag>("hpdEnergyMap",edm::InputTag(""));
   desc.add<double>("energy",-99.0);
   desc.add<double>("hpdSpikeEnergy",10.0);
   desc.add<double>("hpdSpikeIsolationEnergy",1.0);
@@ -101,32 +63,42 @@ HLTHPDFilter::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
 bool HLTHPDFilter::filter(edm::Event& iEvent, const edm::EventSetup& iSetup)
 {
   if (mHPDSpikeEnergyThreshold <= 0 && mRBXSpikeEnergyThreshold <= 0) return true; // nothing to filter
-  // get hits
-  edm::Handle<HBHERecHitCollection> hbhe;
-  iEvent.getByToken(m_theRecHitCollectionToken,hbhe);
-  
-  // collect energies
-  float hpdEnergy[4][73];
-  for (size_t i = 0; i < 4; ++i) for (size_t j = 0; j < 73; ++j) hpdEnergy[i][j] = 0;
-  
-  // select hist above threshold
-  for (unsigned i = 0; i < hbhe->size(); ++i) {
-    if ((*hbhe)[i].energy() > mEnergyThreshold) {
-      std::pair<Partition,int> hpd = hpdId ((*hbhe)[i].id());
-      hpdEnergy[int (hpd.first)][hpd.second] += (*hbhe)[i].energy ();
+  // collect energies, from the shared map if available
+  HcalHPDEnergyMap localMap;
+  const HcalHPDEnergyMap* hpdEnergyMap = &localMap;
+  edm::Handle<HcalHPDEnergyMap> hpdEnergyMap_h;
+  if (mUseHPDEnergyMap) {
+    iEvent.getByToken(m_theHPDEnergyMapToken,hpdEnergyMap_h);
+    if (hpdEnergyMap_h.isValid()) {
+      if (hpdEnergyMap_h->threshold() != mEnergyThreshold)
+	throw cms::Exception("Configuration") << "HLTHPDFilter: HcalHPDEnergyMap " << mHPDEnergyMapTag
+					      << " was filled with an energy threshold of " << hpdEnergyMap_h->threshold()
+					      << " instead of " << mEnergyThreshold << ".\n";
+      hpdEnergyMap = hpdEnergyMap_h.product();
+    }
+    else {
+      edm::LogWarning("HLTHPDFilter") << "Could not find HcalHPDEnergyMap product named "
+				      << mHPDEnergyMapTag << ", using the rec hits instead." << std::endl;
     }
   }
+  if (hpdEnergyMap == &localMap) {
+    // get hits, and select those above threshold
+    edm::Handle<HBHERecHitCollection> hbhe;
+    iEvent.getByToken(m_theRecHitCollectionToken,hbhe);
+    localMap.fill(*hbhe, mEnergyThreshold);
+  }
   
   // not single HPD spike
   if (mHPDSpikeEnergyThreshold > 0) {
-    for (size_t partition = 0; partition < 4; ++partition) {
+    for (size_t partition = 0; partition < HcalHPDEnergyMap::kPartitions; ++partition) {
+      const float* hpdEnergy = hpdEnergyMap->partition(partition);
       for (size_t i = 1; i < 73; ++i) {
-	if (hpdEnergy [partition][i] > mHPDSpikeEnergyThreshold) {
+	if (hpdEnergy[i] > mHPDSpikeEnergyThreshold) {
 	  int hpdPlus = i + 1;
 	  if (hpdPlus == 73) hpdPlus = 1;
 	  int hpdMinus = i - 1;
 	  if (hpdMinus == 0) hpdMinus = 72;
-	  double maxNeighborEnergy = fmax (hpdEnergy[partition][hpdPlus], hpdEnergy[partition][hpdMinus]);
+	  double maxNeighborEnergy = fmax (hpdEnergy[hpdPlus], hpdEnergy[hpdMinus]);
 	  if (maxNeighborEnergy < mHPDSpikeIsolationEnergyThreshold)  return false; // HPD spike found
 	}
       }
@@ -135,7 +107,8 @@ bool HLTHPDFilter::filter(edm::Event& iEvent, const edm::EventSetup& iSetup)
 
   // not RBX flash
   if (mRBXSpikeEnergyThreshold > 0) {
-    for (size_t partition = 0; partition < 4; ++partition) {
+    for (size_t partition = 0; partition < HcalHPDEnergyMap::kPartitions; ++partition) {
+      const float* hpdEnergy = hpdEnergyMap->partition(partition);
       for (size_t rbx = 1; rbx < 19; ++rbx) {
 	int ifirst = (rbx-1)*4-1;
 	int iend = (rbx-1)*4+3;
@@ -145,13 +118,13 @@ bool HLTHPDFilter::filter(edm::Event& iEvent, const edm::EventSetup& iSetup)
 	for (int irm = ifirst; irm < iend; ++irm) {
 	  int hpd = irm;
 	  if (hpd <= 0) hpd = 72 + hpd;
-	  totalEnergy += hpdEnergy[partition][hpd];
+	  totalEnergy += hpdEnergy[hpd];
 	  if (minEnergy > maxEnergy) {
-	    minEnergy = maxEnergy = hpdEnergy[partition][hpd];
+	    minEnergy = maxEnergy = hpdEnergy[hpd];
 	  }
 	  else {
-	    if (hpdEnergy[partition][hpd] < minEnergy) minEnergy = hpdEnergy[partition][hpd];
-	    if (hpdEnergy[partition][hpd] > maxEnergy) maxEnergy = hpdEnergy[partition][hpd];
+	    if (hpdEnergy[hpd] < minEnergy) minEnergy = hpdEnergy[hpd];
+	    if (hpdEnergy[hpd] > maxEnergy) maxEnergy = hpdEnergy[hpd];
 	  }
 	}
 	if (totalEnergy > mRBXSpikeEnergyThreshold) {
@@ -0,0 +1,61 @@
+// -*- C++ -*-
+//
+// Class:      HLTHcalHPDEnergyMapProducer
+// 
+/**\class HLTHcalHPDEnergyMapProducer
+
+ Description: HLT producer of the HBHE energy per HPD, as used by HLTHPDFilter
+
+ Implementation:
+     The partition and HPD of each channel are read from the table of HcalHPDEnergyMap
+*/
+
+#include "HLTrigger/JetMET/interface/HLTHcalHPDEnergyMapProducer.h"
+#include "HLTrigger/JetMET/interface/HcalHPDEnergyMap.h"
+
+#include "DataFormats/Common/interface/Handle.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/EventSetup.h"
+
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+
+HLTHcalHPDEnergyMapProducer::HLTHcalHPDEnergyMapProducer(const edm::ParameterSet& iConfig)
+  : inputTag_(iConfig.getParameter<edm::InputTag>("inputTag")),
+    energyThreshold_(iConfig.getParameter<double>("energy"))
+{
+  m_theRecHitCollectionToken = consumes<HBHERecHitCollection>(inputTag_);
+
+  produces<HcalHPDEnergyMap>();
+}
+
+
+HLTHcalHPDEnergyMapProducer::~HLTHcalHPDEnergyMapProducer(){}
+
+void
+HLTHcalHPDEnergyMapProducer::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+  edm::ParameterSetDescription desc;
+  desc.add<edm::InputTag>("inputTag",edm::InputTag("hltHbhereco"));
+  desc.add<double>("energy",-99.0);
+  descriptions.add("hltHcalHPDEnergyMapProducer",desc);
+}
+
+//
+// member functions
+//
+
+void HLTHcalHPDEnergyMapProducer::produce(edm::Event& iEvent, const edm::EventSetup& iSetup)
+{
+  edm::Handle<HBHERecHitCollection> hbhe;
+  iEvent.getByToken(m_theRecHitCollectionToken,hbhe);
+  if(!hbhe.isValid()) {
+    edm::LogError("DataNotFound") << "HLTHcalHPDEnergyMapProducer: Could not find HBHERecHitCollection product named "
+				  << inputTag_ << "." << std::endl;
+    return;
+  }
+
+  std::auto_ptr<HcalHPDEnergyMap> hpdEnergy(new HcalHPDEnergyMap());
+  hpdEnergy->fill(*hbhe, energyThreshold_);
+  iEvent.put(hpdEnergy);
+}
@@ -29,8 +29,29 @@
 #include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
 #include "FWCore/Utilities/interface/InputTag.h"
 
+#include <algorithm>
 #include <iostream>
 
+namespace {
+  // orders the positions of the thresholds by increasing value
+  struct ThresholdLess {
+    explicit ThresholdLess(const std::vector<double>& thresholds) : thresholds_(thresholds) { }
+    bool operator() (unsigned int i, unsigned int j) const { return thresholds_[i]<thresholds_[j]; }
+    const std::vector<double>& thresholds_;
+  };
+
+  const float adc2fC[128]={-0.5,0.5,1.5,2.5,3.5,4.5,5.5,6.5,7.5,8.5,9.5,10.5,11.5,12.5,
+			   13.5,15.,17.,19.,21.,23.,25.,27.,29.5,32.5,35.5,38.5,42.,46.,50.,54.5,59.5,
+			   64.5,59.5,64.5,69.5,74.5,79.5,84.5,89.5,94.5,99.5,104.5,109.5,114.5,119.5,
+			   124.5,129.5,137.,147.,157.,167.,177.,187.,197.,209.5,224.5,239.5,254.5,272.,
+			   292.,312.,334.5,359.5,384.5,359.5,384.5,409.5,434.5,459.5,484.5,509.5,534.5,
+			   559.5,584.5,609.5,634.5,659.5,684.5,709.5,747.,797.,847.,897.,947.,997.,
+			   1047.,1109.5,1184.5,1259.5,1334.5,1422.,1522.,1622.,1734.5,1859.5,1984.5,
+			   1859.5,1984.5,2109.5,2234.5,2359.5,2484.5,2609.5,2734.5,2859.5,2984.5,
+			   3109.5,3234.5,3359.5,3484.5,3609.5,3797.,4047.,4297.,4547.,4797.,5047.,
+			   5297.,5609.5,5984.5,6359.5,6734.5,7172.,7672.,8172.,8734.5,9359.5,9984.5};
+}
+
 HLTHcalLaserFilter::HLTHcalLaserFilter(const edm::ParameterSet& iConfig) :
   hcalDigiCollection_(iConfig.getParameter<edm::InputTag>("hcalDigiCollection")),
   timeSlices_(iConfig.getParameter<std::vector<int> >("timeSlices")),
@@ -44,6 +65,31 @@ HLTHcalLaserFilter::HLTHcalLaserFilter(const edm::ParameterSet& iConfig) :
   //maxAllowedHFcalib_=10;
 
     m_theCalibToken = consumes<HcalCalibDigiCollection>(hcalDigiCollection_);
+
+    // all QIE bins are multiples of 0.5 fC, so the charges can be summed exactly as integers
+    for (unsigned int i=0;i<128;++i)
+      adc2halffC_[i]=(int)(2*adc2fC[i]);
+
+    for (unsigned int ts=0;ts<timeSlices_.size();++ts)
+      {
+	if (timeSlices_[ts]<0) continue;
+	if (timeSlices_[ts]>=(int)timeSliceWeights_.size())
+	  timeSliceWeights_.resize(timeSlices_[ts]+1,0);
+	++timeSliceWeights_[timeSlices_[ts]];
+      }
+
+    for (unsigned int thresh=0;thresh<thresholdsfC_.size();++thresh)
+      thresholdOrder_.push_back(thresh);
+    std::stable_sort(thresholdOrder_.begin(), thresholdOrder_.end(), ThresholdLess(thresholdsfC_));
+    for (unsigned int thresh=0;thresh<thresholdOrder_.size();++thresh)
+      sortedThresholdsfC_.push_back(thresholdsfC_[thresholdOrder_[thresh]]);
+
+    // the batch evaluation only looks at the multiplicity and charge above each threshold at the end
+    // of the event, which is equivalent to checking them channel by channel as long as they can only
+    // grow, i.e. as long as the thresholds are not negative
+    useBatch_ = CalibCountFilterValues_.size()>=thresholdsfC_.size() && CalibChargeFilterValues_.size()>=thresholdsfC_.size();
+    for (unsigned int thresh=0;thresh<thresholdsfC_.size();++thresh)
+      if (!(thresholdsfC_[thresh]>=0)) useBatch_=false;
 }
 
 
@@ -75,6 +121,9 @@ bool HLTHcalLaserFilter::filter(edm::Event& iEvent, const edm::EventSetup& iSetu
   edm::Handle<HcalCalibDigiCollection> hCalib;
   iEvent.getByToken(m_theCalibToken, hCalib);
 
+  if(hCalib.isValid() == true && useBatch_)
+    return passesBatch(*hCalib);
+
   int numHFcalib=0;
 
   // Set up potential filter variables
@@ -89,17 +138,6 @@ bool HLTHcalLaserFilter::filter(edm::Event& iEvent, const edm::EventSetup& iSetu
       CalibCharge.push_back(0);
     }
 
-  const float adc2fC[128]={-0.5,0.5,1.5,2.5,3.5,4.5,5.5,6.5,7.5,8.5,9.5,10.5,11.5,12.5,
-			   13.5,15.,17.,19.,21.,23.,25.,27.,29.5,32.5,35.5,38.5,42.,46.,50.,54.5,59.5,
-			   64.5,59.5,64.5,69.5,74.5,79.5,84.5,89.5,94.5,99.5,104.5,109.5,114.5,119.5,
-			   124.5,129.5,137.,147.,157.,167.,177.,187.,197.,209.5,224.5,239.5,254.5,272.,
-			   292.,312.,334.5,359.5,384.5,359.5,384.5,409.5,434.5,459.5,484.5,509.5,534.5,
-			   559.5,584.5,609.5,634.5,659.5,684.5,709.5,747.,797.,847.,897.,947.,997.,
-			   1047.,1109.5,1184.5,1259.5,1334.5,1422.,1522.,1622.,1734.5,1859.5,1984.5,
-			   1859.5,1984.5,2109.5,2234.5,2359.5,2484.5,2609.5,2734.5,2859.5,2984.5,
-			   3109.5,3234.5,3359.5,3484.5,3609.5,3797.,4047.,4297.,4547.,4797.,5047.,
-			   5297.,5609.5,5984.5,6359.5,6734.5,7172.,7672.,8172.,8734.5,9359.5,9984.5};
-
   if(hCalib.isValid() == true)
     {
       // loop over calibration channels
@@ -130,7 +168,7 @@ bool HLTHcalLaserFilter::filter(edm::Event& iEvent, const edm::EventSetup& iSetu
 	      
 	      for (unsigned int ts=0;ts<NTS;++ts) // loop over provided timeslices
 		{
-		  if (timeSlices_[ts]<0 || timeSlices_[ts]>digisize) continue;
+		  if (timeSlices_[ts]<0 || timeSlices_[ts]>=digisize) continue;
 		  sumCharge+=adc2fC[digi->sample(timeSlices_[ts]).adc()&0xff];
 		}
 	      
@@ -180,3 +218,76 @@ bool HLTHcalLaserFilter::filter(edm::Event& iEvent, const edm::EventSetup& iSetu
   //std::cout <<"UNFILTERED"<<std::endl;
   return true;
 }
+
+
+bool HLTHcalLaserFilter::passesBatch(const HcalCalibDigiCollection& digis) const
+{
+  // partition the calibration channels: HB/HE ones are kept, HF ones are only counted
+  std::vector<const HcalCalibDataFrame*> hbhe;
+  hbhe.reserve(digis.size());
+  int numHFcalib=0;
+  for(HcalCalibDigiCollection::const_iterator digi = digis.begin(); digi != digis.end(); digi++)
+    {
+      if(digi->id().hcalSubdet() == 0)
+	continue;
+
+      HcalCalibDetId myid=(HcalCalibDetId)digi->id();
+      if (myid.hcalSubdet()==HcalBarrel || myid.hcalSubdet()==HcalEndcap)
+	{
+	  if ( myid.calibFlavor()!=HcalCalibDetId::HOCrosstalk) // ignore HOCrosstalk channels
+	    hbhe.push_back(&*digi);
+	}
+      else if ( myid.hcalSubdet()==HcalForward)
+	++numHFcalib;
+    }
+  if (maxAllowedHFcalib_>=0 && numHFcalib>maxAllowedHFcalib_)
+    return false;
+
+  // charges in units of 0.5 fC; for each channel, the number k of thresholds below its
+  // charge in the selected time slices is found by binary search, and the multiplicity
+  // and charge above each threshold are recovered at the end from the counts per k
+  const unsigned int nThresholds=sortedThresholdsfC_.size();
+  std::vector<int> countAbove(nThresholds+1,0);
+  std::vector<long long> chargeAbove(nThresholds+1,0);
+  const int nWeights=timeSliceWeights_.size();
+  long long totalCalibCharge=0;
+  for(unsigned int c=0;c<hbhe.size();++c)
+    {
+      const HcalCalibDataFrame& digi=*hbhe[c];
+      const int digisize=digi.size();
+
+      int total=0;
+      for(int i=0;i<digisize;++i)
+	total+=adc2halffC_[digi.sample(i).adc()&0x7f];
+
+      totalCalibCharge+=total;
+      if(maxTotalCalibCharge_ >= 0 && 0.5*totalCalibCharge > maxTotalCalibCharge_) return false;
+
+      const int n=std::min(digisize,nWeights);
+      int sumCharge=0;
+      for(int i=0;i<n;++i)
+	sumCharge+=timeSliceWeights_[i]*adc2halffC_[digi.sample(i).adc()&0x7f];
+
+      const unsigned int k=std::lower_bound(sortedThresholdsfC_.begin(), sortedThresholdsfC_.end(), 0.5*sumCharge)-sortedThresholdsfC_.begin();
+      ++countAbove[k];
+      chargeAbove[k]+=sumCharge;
+    }
+
+  // channels above the j-th threshold are those above at least j+1 thresholds
+  int count=0;
+  long long charge=0;
+  for(int j=(int)nThresholds-1;j>=0;--j)
+    {
+      count+=countAbove[j+1];
+      charge+=chargeAbove[j+1];
+      if (count==0)
+	continue;
+      // FilterValues must be >=0 in order for filter to be applied
+      const unsigned int thresh=thresholdOrder_[j];
+      if (CalibCountFilterValues_[thresh]>=0 && count>=CalibCountFilterValues_[thresh])
+	return false;
+      if (CalibChargeFilterValues_[thresh]>=0 && 0.5*charge>=CalibChargeFilterValues_[thresh])
+	return false;
+    }
+  return true;
+}
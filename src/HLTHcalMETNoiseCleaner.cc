@@ -40,50 +40,39 @@
 #include <iostream>
 #include <string>
 #include <fstream>
-#include <TVector3.h>
+#include <cmath>
 #include <TLorentzVector.h>
 //#include <Point.h>
 
+namespace {
+  // transverse momentum of the calotowers of an RBX, summed in the order of the towers;
+  // the tower px and py are those of TVector3::SetPtEtaPhi(pt, eta, phi)
+  void rbxTransverseMomentum(const edm::RefVector<CaloTowerCollection>& towers, double& px, double& py) {
+    px = 0.;
+    py = 0.;
+    for(edm::RefVector<CaloTowerCollection>::const_iterator it = towers.begin(); it != towers.end(); ++it) {
+      px += (*it)->px();
+      py += (*it)->py();
+    }
+  }
+}
+
 HLTHcalMETNoiseCleaner::HLTHcalMETNoiseCleaner(const edm::ParameterSet& iConfig)
   : HcalNoiseRBXCollectionTag_(iConfig.getParameter<edm::InputTag>("HcalNoiseRBXCollection")),
+    HcalNoiseRBXSummaryTag_(iConfig.getParameter<edm::InputTag>("HcalNoiseRBXSummary")),
+    useSummary_(HcalNoiseRBXSummaryTag_.label() != ""),
     CaloMetCollectionTag_(iConfig.getParameter<edm::InputTag>("CaloMetCollection")),
     CaloMetCut_(iConfig.getParameter<double>("CaloMetCut")),
     severity_(iConfig.getParameter<int> ("severity")),
     maxNumRBXs_(iConfig.getParameter<int>("maxNumRBXs")),
     numRBXsToConsider_(iConfig.getParameter<int>("numRBXsToConsider")),
     accept2NoiseRBXEvents_(iConfig.getParameter<bool>("accept2NoiseRBXEvents")),
-    needEMFCoincidence_(iConfig.getParameter<bool>("needEMFCoincidence")),
-    minRBXEnergy_(iConfig.getParameter<double>("minRBXEnergy")),
-    minRatio_(iConfig.getParameter<double>("minRatio")),
-    maxRatio_(iConfig.getParameter<double>("maxRatio")),
-    minHPDHits_(iConfig.getParameter<int>("minHPDHits")),
-    minRBXHits_(iConfig.getParameter<int>("minRBXHits")),
-    minHPDNoOtherHits_(iConfig.getParameter<int>("minHPDNoOtherHits")),
-    minZeros_(iConfig.getParameter<int>("minZeros")),
-    minHighEHitTime_(iConfig.getParameter<double>("minHighEHitTime")),
-    maxHighEHitTime_(iConfig.getParameter<double>("maxHighEHitTime")),
-    maxRBXEMF_(iConfig.getParameter<double>("maxRBXEMF")),
-    minRecHitE_(iConfig.getParameter<double>("minRecHitE")),
-    minLowHitE_(iConfig.getParameter<double>("minLowHitE")),
-    minHighHitE_(iConfig.getParameter<double>("minHighHitE")),
-    TS4TS5EnergyThreshold_(iConfig.getParameter<double>("TS4TS5EnergyThreshold"))
+    selector_(iConfig)
 {
-
-  std::vector<double> TS4TS5UpperThresholdTemp = iConfig.getParameter<std::vector<double> >("TS4TS5UpperThreshold");
-  std::vector<double> TS4TS5UpperCutTemp = iConfig.getParameter<std::vector<double> >("TS4TS5UpperCut");
-  std::vector<double> TS4TS5LowerThresholdTemp = iConfig.getParameter<std::vector<double> >("TS4TS5LowerThreshold");
-  std::vector<double> TS4TS5LowerCutTemp = iConfig.getParameter<std::vector<double> >("TS4TS5LowerCut");
-
-  for(int i = 0; i < (int)TS4TS5UpperThresholdTemp.size() && i < (int)TS4TS5UpperCutTemp.size(); i++)
-     TS4TS5UpperCut_.push_back(std::pair<double, double>(TS4TS5UpperThresholdTemp[i], TS4TS5UpperCutTemp[i]));
-  sort(TS4TS5UpperCut_.begin(), TS4TS5UpperCut_.end());
-
-  for(int i = 0; i < (int)TS4TS5LowerThresholdTemp.size() && i < (int)TS4TS5LowerCutTemp.size(); i++)
-     TS4TS5LowerCut_.push_back(std::pair<double, double>(TS4TS5LowerThresholdTemp[i], TS4TS5LowerCutTemp[i]));
-  sort(TS4TS5LowerCut_.begin(), TS4TS5LowerCut_.end());
-
   m_theCaloMetToken = consumes<reco::CaloMETCollection>(CaloMetCollectionTag_);
   m_theHcalNoiseToken = consumes<reco::HcalNoiseRBXCollection>(HcalNoiseRBXCollectionTag_);
+  if (useSummary_)
+    m_theHcalNoiseSummaryToken = consumes<HcalNoiseRBXSummaryCollection>(HcalNoiseRBXSummaryTag_);
 
   produces<reco::CaloMETCollection>();
 }
@@ -95,41 +84,14 @@ void
 HLTHcalMETNoiseCleaner::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
   edm::ParameterSetDescription desc;
   desc.add<edm::InputTag>("HcalNoiseRBXCollection",edm::InputTag("hltHcalNoiseInfoProducer"));
+  desc.add<edm::InputTag>("HcalNoiseRBXSummary",edm::InputTag(""));
   desc.add<edm::InputTag>("CaloMetCollection",edm::InputTag("hltMet"));
   desc.add<double>("CaloMetCut",0.0);
   desc.add<int>("severity",1);
   desc.add<int>("maxNumRBXs",2);
   desc.add<int>("numRBXsToConsider",2);
   desc.add<bool>("accept2NoiseRBXEvents",true);
-  desc.add<bool>("needEMFCoincidence",true);
-  desc.add<double>("minRBXEnergy",50.0);
-  desc.add<double>("minRatio",-999.);
-  desc.add<double>("maxRatio",999.);
-  desc.add<int>("minHPDHits",17);
-  desc.add<int>("minRBXHits",999);
-  desc.add<int>("minHPDNoOtherHits",10);
-  desc.add<int>("minZeros",10);
-  desc.add<double>("minHighEHitTime",-9999.0);
-  desc.add<double>("maxHighEHitTime",9999.0);
-  desc.add<double>("maxRBXEMF",0.02);
-  desc.add<double>("minRecHitE",1.5);
-  desc.add<double>("minLowHitE",10.0);
-  desc.add<double>("minHighHitE",25.0);
-  desc.add<double>("TS4TS5EnergyThreshold",50.0);
-
-  double TS4TS5UpperThresholdArray[5] = {70, 90, 100, 400, 4000 };
-  double TS4TS5UpperCutArray[5] = {1, 0.8, 0.75, 0.72, 0.72};
-  double TS4TS5LowerThresholdArray[7] = {100, 120, 150, 200, 300, 400, 500};
-  double TS4TS5LowerCutArray[7] = {-1, -0.7, -0.4, -0.2, -0.08, 0, 0.1};
-  std::vector<double> TS4TS5UpperThreshold(TS4TS5UpperThresholdArray, TS4TS5UpperThresholdArray+5);
-  std::vector<double> TS4TS5UpperCut(TS4TS5UpperCutArray, TS4TS5UpperCutArray+5);
-  std::vector<double> TS4TS5LowerThreshold(TS4TS5LowerThresholdArray, TS4TS5LowerThresholdArray+7);
-  std::vector<double> TS4TS5LowerCut(TS4TS5LowerCutArray, TS4TS5LowerCutArray+7);
-
-  desc.add<std::vector<double> >("TS4TS5UpperThreshold", TS4TS5UpperThreshold);
-  desc.add<std::vector<double> >("TS4TS5UpperCut", TS4TS5UpperCut);
-  desc.add<std::vector<double> >("TS4TS5LowerThreshold", TS4TS5LowerThreshold);
-  desc.add<std::vector<double> >("TS4TS5LowerCut", TS4TS5LowerCut);
+  HcalNoiseRBXSelector::fillDescription(desc);
   descriptions.add("hltHcalMETNoiseCleaner",desc);
 }
 
@@ -137,6 +99,12 @@ HLTHcalMETNoiseCleaner::fillDescriptions(edm::ConfigurationDescriptions& descrip
 // member functions
 //
 
+void HLTHcalMETNoiseCleaner::endJob()
+{
+  // which noise criteria fired over the job
+  selector_.report("HLTHcalMETNoiseCleaner");
+}
+
 bool HLTHcalMETNoiseCleaner::filter(edm::Event& iEvent, const edm::EventSetup& iSetup)
 {
   using namespace reco;
@@ -173,13 +141,21 @@ bool HLTHcalMETNoiseCleaner::filter(edm::Event& iEvent, const edm::EventSetup& i
     return true; // no valid RBXs
   }
 
-  // create a sorted set of the RBXs, ordered by energy
-  noisedataset_t data;
-  for(HcalNoiseRBXCollection::const_iterator it=rbxs_h->begin(); it!=rbxs_h->end(); ++it) {
-    const HcalNoiseRBX &rbx=(*it);
-    CommonHcalNoiseRBXData d(rbx, minRecHitE_, minLowHitE_, minHighHitE_, TS4TS5EnergyThreshold_,
-			     TS4TS5UpperCut_, TS4TS5LowerCut_);
-    data.insert(d);
+  // RBX summaries sorted by energy, either from HLTHcalNoiseRBXSummaryProducer or computed here
+  HcalNoiseRBXSummaryCollection data;
+  if(useSummary_) {
+    edm::Handle<HcalNoiseRBXSummaryCollection> summaries_h;
+    iEvent.getByToken(m_theHcalNoiseSummaryToken,summaries_h);
+    if(!summaries_h.isValid()) {
+      edm::LogError("DataNotFound") << "HLTHcalMETNoiseCleaner: Could not find HcalNoiseRBXSummary product named "
+				    << HcalNoiseRBXSummaryTag_ << "." << std::endl;
+      CleanedMET->push_back(inCaloMet);
+      iEvent.put(CleanedMET);
+      return true; // no valid RBXs
+    }
+    selector_.select(*summaries_h, data, numRBXsToConsider_);
+  } else {
+    selector_.summarize(*rbxs_h, data, numRBXsToConsider_);
   }
   //if 0 RBXs are in the list, just accept
   if(data.size()<1){
@@ -192,35 +168,14 @@ bool HLTHcalMETNoiseCleaner::filter(edm::Event& iEvent, const edm::EventSetup& i
   int cntr=0;
   int nNoise=0;
 
-  TVector3 metVec;
-  metVec.SetPtEtaPhi(met_h->front().pt(), 0, met_h->front().phi() );
-
-  TVector3 noiseHPDVector(0,0,0);
-  TVector3 secondHPDVector(0,0,0);
-  for(noisedataset_t::const_iterator it=data.begin();
+  // transverse momenta of the noisy leading RBX and of the second RBX
+  double noisePx=0., noisePy=0.;
+  double secondPx=0., secondPy=0.;
+  for(HcalNoiseRBXSummaryCollection::const_iterator it=data.begin();
       it!=data.end() && cntr<numRBXsToConsider_;
       it++, cntr++) {
     bool isNoise=false;
-    bool passFilter=true;
-    bool passEMF=true;
-    if(it->energy()>minRBXEnergy_) {
-      if(it->validRatio() && it->ratio()<minRatio_)        passFilter=false;
-      else if(it->validRatio() && it->ratio()>maxRatio_)   passFilter=false;
-      else if(it->numHPDHits()>=minHPDHits_)               passFilter=false;
-      else if(it->numRBXHits()>=minRBXHits_)               passFilter=false;
-      else if(it->numHPDNoOtherHits()>=minHPDNoOtherHits_) passFilter=false;
-      else if(it->numZeros()>=minZeros_)                   passFilter=false;
-      else if(it->minHighEHitTime()<minHighEHitTime_)      passFilter=false;
-      else if(it->maxHighEHitTime()>maxHighEHitTime_)      passFilter=false;
-      else if(!it->PassTS4TS5())                           passFilter=false;
-
-      if(it->RBXEMF()<maxRBXEMF_){
-	passEMF=false;
-      }
-    }
-    
-    if((needEMFCoincidence_ && !passEMF && !passFilter) ||
-       (!needEMFCoincidence_ && !passFilter)) { // check for noise
+    if(selector_.isNoise(*it)) { // check for noise
       LogDebug("") << "HLTHcalMETNoiseCleaner debug: Found a noisy RBX: "
 		   << "energy=" << it->energy() << "; "
 		   << "ratio=" << it->ratio() << "; "
@@ -238,16 +193,8 @@ bool HLTHcalMETNoiseCleaner::filter(edm::Event& iEvent, const edm::EventSetup& i
 
     //------------First Noisy RBX-----------------------
     if(isNoise && nNoise==1){
-      edm::RefVector<CaloTowerCollection> noiseTowers = it->rbxTowers();
-      edm::RefVector<CaloTowerCollection>::const_iterator noiseTowersIt;
-      // get the energy vector for this RBX from the calotowers
-      for( noiseTowersIt = noiseTowers.begin(); noiseTowersIt != noiseTowers.end(); noiseTowersIt++){
-	TVector3 towerVec;
-	towerVec.SetPtEtaPhi((*noiseTowersIt)->pt(),(*noiseTowersIt)->eta(),(*noiseTowersIt)->phi());
-	noiseHPDVector+=towerVec; // add this tower to the vector for the RBX
-      }
-      if(noiseHPDVector.Mag()>0) noiseHPDVector.SetPtEtaPhi(noiseHPDVector.Pt(),0,noiseHPDVector.Phi()); // make the noise transverse
-      else noiseHPDVector.SetPtEtaPhi(0,0,0);
+      // get the momentum for this RBX from the calotowers
+      rbxTransverseMomentum(it->rbxTowers(), noisePx, noisePy);
     }
     //-----------FOUND a SECOND NOISY RBX-------------------
     if(isNoise && cntr > 0){ 
@@ -263,20 +210,13 @@ bool HLTHcalMETNoiseCleaner::filter(edm::Event& iEvent, const edm::EventSetup& i
     }
     //-----------SUBLEADING RBX is NOT NOISY: STORE INFO----
     if(!isNoise && nNoise>0){ //second RBX isn't noisy (and first one was), so clean 
-      edm::RefVector<CaloTowerCollection> noiseTowers = it->rbxTowers();
-      edm::RefVector<CaloTowerCollection>::const_iterator noiseTowersIt;
-	for( noiseTowersIt = noiseTowers.begin(); noiseTowersIt != noiseTowers.end(); noiseTowersIt++){
-	  TVector3 towerVec;
-	  towerVec.SetPtEtaPhi((*noiseTowersIt)->pt(),(*noiseTowersIt)->eta(),(*noiseTowersIt)->phi());
-	  secondHPDVector+=towerVec; // add this tower to the vector for the RBX
-	}
-	if(secondHPDVector.Mag()>0) secondHPDVector.SetPtEtaPhi(secondHPDVector.Pt(),0,secondHPDVector.Phi()); // make the second transverse
-	else secondHPDVector.SetPtEtaPhi(0,0,0);
-	break;
+      rbxTransverseMomentum(it->rbxTowers(), secondPx, secondPy);
+      break;
     }
   } // end RBX loop
 
-  if(noiseHPDVector.Mag()==0){
+  const double noisePt = std::sqrt(noisePx*noisePx + noisePy*noisePy);
+  if(noisePt==0){
     CleanedMET->push_back(inCaloMet);
     iEvent.put(CleanedMET);   	
     return true; // don't reject the event if the leading RBX isn't noise
@@ -288,23 +228,26 @@ bool HLTHcalMETNoiseCleaner::filter(edm::Event& iEvent, const edm::EventSetup& i
 
   float METsumet = met_h->front().energy();
 
-  metVec+=noiseHPDVector;
+  // only the transverse components matter: the RBX momenta are made transverse
+  double metPx = met_h->front().px() + noisePx;
+  double metPy = met_h->front().py() + noisePy;
 
-  float ZMETsumet = METsumet-noiseHPDVector.Mag();
-  float ZMETpt = metVec.Pt();
-  float ZMETphi = metVec.Phi();
+  float ZMETsumet = METsumet-noisePt;
+  float ZMETpt = std::sqrt(metPx*metPx + metPy*metPy);
+  float ZMETphi = std::atan2(metPy, metPx);
 
-  //put the second RBX vector in the eta phi position of the leading RBX vector
+  //put the second RBX vector in the phi position of the leading RBX vector
  
   float SMETsumet = 0;
   float SMETpt = 0;
   float SMETphi = 0;
- if(secondHPDVector.Mag()>0.){
-    secondHPDVector.SetPtEtaPhi(secondHPDVector.Pt(),noiseHPDVector.Eta(),noiseHPDVector.Phi());
-    metVec-= secondHPDVector;
-    SMETsumet = METsumet-noiseHPDVector.Mag();
-    SMETpt = metVec.Pt();
-    SMETphi = metVec.Phi();  
+  const double secondPt = std::sqrt(secondPx*secondPx + secondPy*secondPy);
+  if(secondPt>0.){
+    metPx -= secondPt/noisePt * noisePx;
+    metPy -= secondPt/noisePt * noisePy;
+    SMETsumet = METsumet-noisePt;
+    SMETpt = std::sqrt(metPx*metPx + metPy*metPy);
+    SMETphi = std::atan2(metPy, metPx);
   }
   //Get the maximum MET:
   float CorMetSumEt,CorMetPt,CorMetPhi;
@@ -0,0 +1,70 @@
+// -*- C++ -*-
+//
+// Class:      HLTHcalNoiseRBXSummaryProducer
+// 
+/**\class HLTHcalNoiseRBXSummaryProducer
+
+ Description: HLT producer of the RBX noise summaries shared by the HCAL noise filter and cleaners
+
+ Implementation:
+     The RBXs are sorted by energy, and each summary carries the criteria it fails with the
+     thresholds of this module; the consumers evaluate them again with their own thresholds
+*/
+
+#include "HLTrigger/JetMET/interface/HLTHcalNoiseRBXSummaryProducer.h"
+
+#include "DataFormats/Common/interface/Handle.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/EventSetup.h"
+
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+
+HLTHcalNoiseRBXSummaryProducer::HLTHcalNoiseRBXSummaryProducer(const edm::ParameterSet& iConfig)
+  : HcalNoiseRBXCollectionTag_(iConfig.getParameter<edm::InputTag>("HcalNoiseRBXCollection")),
+    numRBXsToConsider_(iConfig.getParameter<int>("numRBXsToConsider")),
+    selector_(iConfig)
+{
+  m_theHcalNoiseToken = consumes<reco::HcalNoiseRBXCollection>(HcalNoiseRBXCollectionTag_);
+
+  produces<HcalNoiseRBXSummaryCollection>();
+}
+
+
+HLTHcalNoiseRBXSummaryProducer::~HLTHcalNoiseRBXSummaryProducer(){}
+
+void
+HLTHcalNoiseRBXSummaryProducer::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+  edm::ParameterSetDescription desc;
+  desc.add<edm::InputTag>("HcalNoiseRBXCollection",edm::InputTag("hltHcalNoiseInfoProducer"));
+  desc.add<int>("numRBXsToConsider",-1);
+  HcalNoiseRBXSelector::fillDescription(desc);
+  descriptions.add("hltHcalNoiseRBXSummaryProducer",desc);
+}
+
+//
+// member functions
+//
+
+void HLTHcalNoiseRBXSummaryProducer::endJob()
+{
+  // which noise criteria fired over the job
+  selector_.report("HLTHcalNoiseRBXSummaryProducer");
+}
+
+void HLTHcalNoiseRBXSummaryProducer::produce(edm::Event& iEvent, const edm::EventSetup& iSetup)
+{
+  // get the RBXs produced by RecoMET/METProducers/HcalNoiseInfoProducer
+  edm::Handle<reco::HcalNoiseRBXCollection> rbxs_h;
+  iEvent.getByToken(m_theHcalNoiseToken,rbxs_h);
+  if(!rbxs_h.isValid()) {
+    edm::LogError("DataNotFound") << "HLTHcalNoiseRBXSummaryProducer: Could not find HcalNoiseRBXCollection product named "
+				  << HcalNoiseRBXCollectionTag_ << "." << std::endl;
+    return;
+  }
+
+  std::auto_ptr<HcalNoiseRBXSummaryCollection> summaries(new HcalNoiseRBXSummaryCollection());
+  selector_.summarize(*rbxs_h, *summaries, numRBXsToConsider_);
+  iEvent.put(summaries);
+}
@@ -41,7 +41,6 @@
 #include <fstream>
 #include <TVector3.h>
 #include <TLorentzVector.h>
-#include <set>
 
 #include "HLTrigger/JetMET/interface/HLTHcalTowerNoiseCleaner.h"
 
@@ -49,44 +48,25 @@
 
 HLTHcalTowerNoiseCleaner::HLTHcalTowerNoiseCleaner(const edm::ParameterSet& iConfig)
   : HcalNoiseRBXCollectionTag_(iConfig.getParameter<edm::InputTag>("HcalNoiseRBXCollection")),
+    HcalNoiseRBXSummaryTag_(iConfig.getParameter<edm::InputTag>("HcalNoiseRBXSummary")),
+    useSummary_(HcalNoiseRBXSummaryTag_.label() != ""),
     TowerCollectionTag_(iConfig.getParameter<edm::InputTag>("CaloTowerCollection")),
     severity_(iConfig.getParameter<int> ("severity")),
     maxNumRBXs_(iConfig.getParameter<int>("maxNumRBXs")),
     numRBXsToConsider_(iConfig.getParameter<int>("numRBXsToConsider")),
-    needEMFCoincidence_(iConfig.getParameter<bool>("needEMFCoincidence")),
-    minRBXEnergy_(iConfig.getParameter<double>("minRBXEnergy")),
-    minRatio_(iConfig.getParameter<double>("minRatio")),
-    maxRatio_(iConfig.getParameter<double>("maxRatio")),
-    minHPDHits_(iConfig.getParameter<int>("minHPDHits")),
-    minRBXHits_(iConfig.getParameter<int>("minRBXHits")),
-    minHPDNoOtherHits_(iConfig.getParameter<int>("minHPDNoOtherHits")),
-    minZeros_(iConfig.getParameter<int>("minZeros")),
-    minHighEHitTime_(iConfig.getParameter<double>("minHighEHitTime")),
-    maxHighEHitTime_(iConfig.getParameter<double>("maxHighEHitTime")),
-    maxRBXEMF_(iConfig.getParameter<double>("maxRBXEMF")),
-    minRecHitE_(iConfig.getParameter<double>("minRecHitE")),
-    minLowHitE_(iConfig.getParameter<double>("minLowHitE")),
-    minHighHitE_(iConfig.getParameter<double>("minHighHitE")),
-    TS4TS5EnergyThreshold_(iConfig.getParameter<double>("TS4TS5EnergyThreshold"))
+    onlyLeadingRBXs_(iConfig.getParameter<bool>("onlyLeadingRBXs")),
+    produceRefs_(iConfig.getParameter<bool>("produceRefs")),
+    selector_(iConfig)
 {
-
-  std::vector<double> TS4TS5UpperThresholdTemp = iConfig.getParameter<std::vector<double> >("TS4TS5UpperThreshold");
-  std::vector<double> TS4TS5UpperCutTemp = iConfig.getParameter<std::vector<double> >("TS4TS5UpperCut");
-  std::vector<double> TS4TS5LowerThresholdTemp = iConfig.getParameter<std::vector<double> >("TS4TS5LowerThreshold");
-  std::vector<double> TS4TS5LowerCutTemp = iConfig.getParameter<std::vector<double> >("TS4TS5LowerCut");
-
-  for(int i = 0; i < (int)TS4TS5UpperThresholdTemp.size() && i < (int)TS4TS5UpperCutTemp.size(); i++)
-     TS4TS5UpperCut_.push_back(std::pair<double, double>(TS4TS5UpperThresholdTemp[i], TS4TS5UpperCutTemp[i]));
-  sort(TS4TS5UpperCut_.begin(), TS4TS5UpperCut_.end());
-
-  for(int i = 0; i < (int)TS4TS5LowerThresholdTemp.size() && i < (int)TS4TS5LowerCutTemp.size(); i++)
-     TS4TS5LowerCut_.push_back(std::pair<double, double>(TS4TS5LowerThresholdTemp[i], TS4TS5LowerCutTemp[i]));
-  sort(TS4TS5LowerCut_.begin(), TS4TS5LowerCut_.end());
-
   m_theHcalNoiseToken = consumes<reco::HcalNoiseRBXCollection>(HcalNoiseRBXCollectionTag_);
+  if (useSummary_)
+    m_theHcalNoiseSummaryToken = consumes<HcalNoiseRBXSummaryCollection>(HcalNoiseRBXSummaryTag_);
   m_theCaloTowerCollectionToken = consumes<CaloTowerCollection>(TowerCollectionTag_);
 
-  produces<CaloTowerCollection>();
+  if (produceRefs_)
+    produces<edm::RefVector<CaloTowerCollection> >();
+  else
+    produces<CaloTowerCollection>();
 }
 
 
@@ -96,40 +76,15 @@ void
 HLTHcalTowerNoiseCleaner::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
   edm::ParameterSetDescription desc;
   desc.add<edm::InputTag>("HcalNoiseRBXCollection",edm::InputTag("hltHcalNoiseInfoProducer"));
+  desc.add<edm::InputTag>("HcalNoiseRBXSummary",edm::InputTag(""));
   desc.add<edm::InputTag>("CaloTowerCollection",edm::InputTag("hltTowerMakerForAll"));
   desc.add<double>("maxTowerNoiseEnergyFraction",0.5);
   desc.add<int>("severity",1);
   desc.add<int>("maxNumRBXs",2);
   desc.add<int>("numRBXsToConsider",2);
-  desc.add<bool>("needEMFCoincidence",true);
-  desc.add<double>("minRBXEnergy",50.0);
-  desc.add<double>("minRatio",-999.);
-  desc.add<double>("maxRatio",999.);
-  desc.add<int>("minHPDHits",17);
-  desc.add<int>("minRBXHits",999);
-  desc.add<int>("minHPDNoOtherHits",10);
-  desc.add<int>("minZeros",10);
-  desc.add<double>("minHighEHitTime",-9999.0);
-  desc.add<double>("maxHighEHitTime",9999.0);
-  desc.add<double>("maxRBXEMF",0.02);
-  desc.add<double>("minRecHitE",1.5);
-  desc.add<double>("minLowHitE",10.0);
-  desc.add<double>("minHighHitE",25.0);
-  desc.add<double>("TS4TS5EnergyThreshold",50.0);
-
-  double TS4TS5UpperThresholdArray[5] = {70, 90, 100, 400, 4000 };
-  double TS4TS5UpperCutArray[5] = {1, 0.8, 0.75, 0.72, 0.72};
-  double TS4TS5LowerThresholdArray[7] = {100, 120, 150, 200, 300, 400, 500};
-  double TS4TS5LowerCutArray[7] = {-1, -0.7, -0.4, -0.2, -0.08, 0, 0.1};
-  std::vector<double> TS4TS5UpperThreshold(TS4TS5UpperThresholdArray, TS4TS5UpperThresholdArray+5);
-  std::vector<double> TS4TS5UpperCut(TS4TS5UpperCutArray, TS4TS5UpperCutArray+5);
-  std::vector<double> TS4TS5LowerThreshold(TS4TS5LowerThresholdArray, TS4TS5LowerThresholdArray+7);
-  std::vector<double> TS4TS5LowerCut(TS4TS5LowerCutArray, TS4TS5LowerCutArray+7);
-
-  desc.add<std::vector<double> >("TS4TS5UpperThreshold", TS4TS5UpperThreshold);
-  desc.add<std::vector<double> >("TS4TS5UpperCut", TS4TS5UpperCut);
-  desc.add<std::vector<double> >("TS4TS5LowerThreshold", TS4TS5LowerThreshold);
-  desc.add<std::vector<double> >("TS4TS5LowerCut", TS4TS5LowerCut);
+  desc.add<bool>("onlyLeadingRBXs",false);
+  desc.add<bool>("produceRefs",false);
+  HcalNoiseRBXSelector::fillDescription(desc);
   descriptions.add("hltHcalTowerNoiseCleaner",desc);
 }
 
@@ -137,6 +92,12 @@ HLTHcalTowerNoiseCleaner::fillDescriptions(edm::ConfigurationDescriptions& descr
 // member functions
 //
 
+void HLTHcalTowerNoiseCleaner::endJob()
+{
+  // which noise criteria fired over the job
+  selector_.report("HLTHcalTowerNoiseCleaner");
+}
+
 void HLTHcalTowerNoiseCleaner::produce(edm::Event& iEvent, const edm::EventSetup& iSetup)
 {
   using namespace reco;
@@ -145,7 +106,8 @@ void HLTHcalTowerNoiseCleaner::produce(edm::Event& iEvent, const edm::EventSetup
   edm::Handle<CaloTowerCollection> tower_h;
   iEvent.getByToken(m_theCaloTowerCollectionToken,tower_h);
   
-  std::set<unsigned int> noisyTowers;
+  // noisy towers, indexed by CaloTowerDetId::denseIndex()
+  std::vector<bool> noisyTowers;
 
   if(not tower_h.isValid()){ //No towers MET, don't do anything and accept the event
     edm::LogError("HLTHcalTowerNoiseCleaner") << "Input Tower Collection is not Valid";
@@ -153,52 +115,42 @@ void HLTHcalTowerNoiseCleaner::produce(edm::Event& iEvent, const edm::EventSetup
   }
 
   
-  // get the RBXs produced by RecoMET/METProducers/HcalNoiseInfoProducer
-  edm::Handle<HcalNoiseRBXCollection> rbxs_h;
-  iEvent.getByToken(m_theHcalNoiseToken,rbxs_h);
-  if(!rbxs_h.isValid()) {
-    edm::LogWarning("HLTHcalTowerNoiseCleaner") << "Could not find HcalNoiseRBXCollection product named "
-					      << HcalNoiseRBXCollectionTag_ << "." << std::endl;
-    severity_=0;
-  }
-		
-  // create a sorted set of the RBXs, ordered by energy
-  noisedataset_t data;
-  for(HcalNoiseRBXCollection::const_iterator it=rbxs_h->begin(); it!=rbxs_h->end(); ++it) {
-    const HcalNoiseRBX &rbx=(*it);
-    CommonHcalNoiseRBXData d(rbx, minRecHitE_, minLowHitE_, minHighHitE_, TS4TS5EnergyThreshold_,
-			     TS4TS5UpperCut_, TS4TS5LowerCut_);
-    data.insert(d);
+  // RBX summaries sorted by energy, either from HLTHcalNoiseRBXSummaryProducer or computed here
+  bool cleanTowers = severity_>0;
+  const int maxRBXs = onlyLeadingRBXs_ ? numRBXsToConsider_ : -1;
+  HcalNoiseRBXSummaryCollection data;
+  if(cleanTowers && useSummary_) {
+    edm::Handle<HcalNoiseRBXSummaryCollection> summaries_h;
+    iEvent.getByToken(m_theHcalNoiseSummaryToken,summaries_h);
+    if(!summaries_h.isValid()) {
+      edm::LogWarning("HLTHcalTowerNoiseCleaner") << "Could not find HcalNoiseRBXSummary product named "
+						<< HcalNoiseRBXSummaryTag_ << "." << std::endl;
+      cleanTowers=false;
+    } else {
+      selector_.select(*summaries_h, data, maxRBXs);
+    }
+  } else if(cleanTowers) {
+    // get the RBXs produced by RecoMET/METProducers/HcalNoiseInfoProducer
+    edm::Handle<HcalNoiseRBXCollection> rbxs_h;
+    iEvent.getByToken(m_theHcalNoiseToken,rbxs_h);
+    if(!rbxs_h.isValid()) {
+      edm::LogWarning("HLTHcalTowerNoiseCleaner") << "Could not find HcalNoiseRBXCollection product named "
+						<< HcalNoiseRBXCollectionTag_ << "." << std::endl;
+      cleanTowers=false;
+    } else {
+      selector_.summarize(*rbxs_h, data, maxRBXs);
+    }
   }
-		
+
   // data is now sorted by RBX energy
-  // only consider top N=numRBXsToConsider_ energy RBXs
-  if(severity_>0){
-    for(noisedataset_t::const_iterator it=data.begin();
-	it!=data.end();
-	it++) {
-      
+  // if onlyLeadingRBXs_, only consider top N=numRBXsToConsider_ energy RBXs
+  if(cleanTowers){
+    int cntr=0;
+    for(HcalNoiseRBXSummaryCollection::const_iterator it=data.begin();
+	it!=data.end() && (maxRBXs<0 || cntr<maxRBXs);
+	it++, cntr++) {
       
-      bool passFilter=true;
-      bool passEMF=true;
-      if(it->energy()>minRBXEnergy_) {
-	if(it->validRatio() && it->ratio()<minRatio_)        passFilter=false;
-	else if(it->validRatio() && it->ratio()>maxRatio_)   passFilter=false;
-	else if(it->numHPDHits()>=minHPDHits_)               passFilter=false;
-	else if(it->numRBXHits()>=minRBXHits_)               passFilter=false;
-	else if(it->numHPDNoOtherHits()>=minHPDNoOtherHits_) passFilter=false;
-	else if(it->numZeros()>=minZeros_)                   passFilter=false;
-	else if(it->minHighEHitTime()<minHighEHitTime_)      passFilter=false;
-	else if(it->maxHighEHitTime()>maxHighEHitTime_)      passFilter=false;
-	else if(!it->PassTS4TS5())                           passFilter=false;
-	
-	if(it->RBXEMF()<maxRBXEMF_){
-	  passEMF=false;
-	}
-      }
-      
-      if((needEMFCoincidence_ && !passEMF && !passFilter) ||
-	 (!needEMFCoincidence_ && !passFilter)) { // check for noise
+      if(selector_.isNoise(*it)) { // check for noise
 	LogDebug("") << "HLTHcalTowerNoiseCleaner debug: Found a noisy RBX: "
 		     << "energy=" << it->energy() << "; "
 		     << "ratio=" << it->ratio() << "; "
@@ -217,20 +169,35 @@ void HLTHcalTowerNoiseCleaner::produce(edm::Event& iEvent, const edm::EventSetup
 	for( noiseTowersIt = noiseTowers.begin(); noiseTowersIt != noiseTowers.end(); noiseTowersIt++){
 	  edm::Ref<edm::SortedCollection<CaloTower> > tower_ref = *noiseTowersIt;
 	  CaloTowerDetId id = tower_ref->id();
-	  noisyTowers.insert( id.denseIndex() );
+	  if(id.denseIndex() >= noisyTowers.size()) noisyTowers.resize(id.denseIndex()+1, false);
+	  noisyTowers[id.denseIndex()] = true;
 	}}
     } // done with noise loop
-  }//if(severity_>0)
+  }//if(cleanTowers)
   
+  if(produceRefs_){
+    // refer to the good towers of the input collection, without copying them
+    std::auto_ptr<edm::RefVector<CaloTowerCollection> > OutputTowerRefs(new edm::RefVector<CaloTowerCollection>() );
+    for(unsigned int i = 0; i < tower_h->size(); ++i){
+      const unsigned int index = (*tower_h)[i].id().denseIndex();
+      if(index >= noisyTowers.size() || !noisyTowers[index]){ // the tower is not noisy
+	OutputTowerRefs->push_back(edm::Ref<CaloTowerCollection>(tower_h, i));
+      }
+    }
+    iEvent.put(OutputTowerRefs);
+    return;
+  }
+
   //output collection
   std::auto_ptr<CaloTowerCollection> OutputTowers(new CaloTowerCollection() );
+  OutputTowers->reserve(tower_h->size());
 
   CaloTowerCollection::const_iterator inTowersIt;
   
   for(inTowersIt = tower_h->begin(); inTowersIt != tower_h->end(); inTowersIt++){
     const CaloTower & tower = (*inTowersIt);
     CaloTowerDetId id = tower.id();
-    if(noisyTowers.find( id.denseIndex() ) == noisyTowers.end()){ // the tower is not noisy
+    if(id.denseIndex() >= noisyTowers.size() || !noisyTowers[id.denseIndex()]){ // the tower is not noisy
       OutputTowers->push_back(*inTowersIt);
     }
   }
@@ -8,10 +8,13 @@
 
 #include "HLTrigger/JetMET/interface/HLTHtMhtProducer.h"
 
+#include <algorithm>
+
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 #include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
 #include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
 #include "DataFormats/Common/interface/Handle.h"
+#include "FWCore/Utilities/interface/Exception.h"
 
 
 // Constructor
@@ -25,9 +28,15 @@ HLTHtMhtProducer::HLTHtMhtProducer(const edm::ParameterSet & iConfig) :
   maxEtaJetHt_            ( iConfig.getParameter<double>("maxEtaJetHt") ),
   maxEtaJetMht_           ( iConfig.getParameter<double>("maxEtaJetMht") ),
   jetsLabel_              ( iConfig.getParameter<edm::InputTag>("jetsLabel") ),
-  pfCandidatesLabel_      ( iConfig.getParameter<edm::InputTag>("pfCandidatesLabel") ) {
-    m_theJetToken = consumes<edm::View<reco::Jet>>(jetsLabel_);
+  pfCandidatesLabel_      ( iConfig.getParameter<edm::InputTag>("pfCandidatesLabel") ),
+  jetKinematicsLabel_     ( iConfig.getParameter<edm::InputTag>("jetKinematicsLabel") ),
+  useJetKinematics_       ( jetKinematicsLabel_.label() != "" ),
+  pfLightCandidatesLabel_ ( iConfig.getParameter<edm::InputTag>("pfLightCandidatesLabel") ),
+  usePFLightCandidates_   ( pfLightCandidatesLabel_.label() != "" ) {
+    if (useJetKinematics_) m_theJetKinematicsToken = consumes<JetKinematics>(jetKinematicsLabel_);
+    else m_theJetToken = consumes<edm::View<reco::Jet>>(jetsLabel_);
     m_thePFCandidateToken = consumes<reco::PFCandidateCollection>(pfCandidatesLabel_);
+    if (usePFLightCandidates_) m_thePFLightCandidateToken = consumes<PFLightCandidates>(pfLightCandidatesLabel_);
 
     // Register the products
     produces<reco::METCollection>();
@@ -50,50 +59,79 @@ void HLTHtMhtProducer::fillDescriptions(edm::ConfigurationDescriptions & descrip
     desc.add<double>("maxEtaJetMht", 5.);
     desc.add<edm::InputTag>("jetsLabel", edm::InputTag("hltCaloJetL1FastJetCorrected"));
     desc.add<edm::InputTag>("pfCandidatesLabel",  edm::InputTag("hltParticleFlow"));
+    desc.add<edm::InputTag>("pfLightCandidatesLabel",  edm::InputTag(""));
+    desc.add<edm::InputTag>("jetKinematicsLabel",  edm::InputTag(""));
     descriptions.add("hltHtMhtProducer", desc);
 }
 
+// Add a jet to the sums
+template <class J>
+void HLTHtMhtProducer::addJet(J const & jet, int & nj_ht, int & nj_mht, double & ht, double & mhx, double & mhy) const {
+    double pt = usePt_ ? jet.pt() : jet.et();
+    double eta = jet.eta();
+    double phi = jet.phi();
+    double px = usePt_ ? jet.px() : jet.et() * cos(phi);
+    double py = usePt_ ? jet.py() : jet.et() * sin(phi);
+
+    if (pt > minPtJetHt_ && std::abs(eta) < maxEtaJetHt_) {
+        ht += pt;
+        ++nj_ht;
+    }
+
+    if (pt > minPtJetMht_ && std::abs(eta) < maxEtaJetMht_) {
+        mhx -= px;
+        mhy -= py;
+        ++nj_mht;
+    }
+}
+
 // Produce the products
 void HLTHtMhtProducer::produce(edm::Event& iEvent, const edm::EventSetup& iSetup) {
 
     // Create a pointer to the products
     std::auto_ptr<reco::METCollection> result(new reco::METCollection());
 
-    if (pfCandidatesLabel_.label() == "")
+    if (pfCandidatesLabel_.label() == "" && !usePFLightCandidates_)
         excludePFMuons_ = false;
 
     edm::Handle<reco::JetView> jets;
-    iEvent.getByToken(m_theJetToken, jets);
+    edm::Handle<JetKinematics> jetKinematics;
+    if (useJetKinematics_)
+        iEvent.getByToken(m_theJetKinematicsToken, jetKinematics);
+    else
+        iEvent.getByToken(m_theJetToken, jets);
 
     edm::Handle<reco::PFCandidateCollection> pfCandidates;
-    if (excludePFMuons_)
+    edm::Handle<PFLightCandidates> pfLightCandidates;
+    if (excludePFMuons_ && usePFLightCandidates_)
+        iEvent.getByToken(m_thePFLightCandidateToken, pfLightCandidates);
+    else if (excludePFMuons_)
         iEvent.getByToken(m_thePFCandidateToken, pfCandidates);
 
     int nj_ht = 0, nj_mht = 0;
     double ht = 0., mhx = 0., mhy = 0.;
 
-    if (jets->size() > 0) {
-        for(reco::JetView::const_iterator j = jets->begin(); j != jets->end(); ++j) {
-            double pt = usePt_ ? j->pt() : j->et();
-            double eta = j->eta();
-            double phi = j->phi();
-            double px = usePt_ ? j->px() : j->et() * cos(phi);
-            double py = usePt_ ? j->py() : j->et() * sin(phi);
-
-            if (pt > minPtJetHt_ && std::abs(eta) < maxEtaJetHt_) {
-                ht += pt;
-                ++nj_ht;
-            }
-
-            if (pt > minPtJetMht_ && std::abs(eta) < maxEtaJetMht_) {
-                mhx -= px;
-                mhy -= py;
-                ++nj_mht;
-            }
-        }
+    if (useJetKinematics_) {
+        const JetKinematics & kin = *jetKinematics;
+        // the jets not stored must fail the pt requirements
+        if (kin.preselected() && (!usePt_ || kin.minPt() > std::min(minPtJetHt_, minPtJetMht_)))
+            throw cms::Exception("Configuration") << "HLTHtMhtProducer: JetKinematics " << jetKinematicsLabel_
+                                                  << " only has the jets with pt > " << kin.minPt() << ".\n";
+        for (unsigned int j = 0; j < kin.size(); ++j)
+            addJet(kin[j], nj_ht, nj_mht, ht, mhx, mhy);
+
+    } else if (jets->size() > 0) {
+        for(reco::JetView::const_iterator j = jets->begin(); j != jets->end(); ++j)
+            addJet(*j, nj_ht, nj_mht, ht, mhx, mhy);
     }
 
-    if (excludePFMuons_) {
+    if (excludePFMuons_ && usePFLightCandidates_) {
+        const std::vector<unsigned int> & muons = pfLightCandidates->muons();
+        for (unsigned int i = 0; i < muons.size(); ++i) {
+            mhx += pfLightCandidates->px()[muons[i]];
+            mhy += pfLightCandidates->py()[muons[i]];
+        }
+    } else if (excludePFMuons_) {
         for (reco::PFCandidateCollection::const_iterator j = pfCandidates->begin(); j != pfCandidates->end(); ++j) {
             if (std::abs(j->pdgId()) == 13) {
                 mhx += j->px();
@@ -0,0 +1,133 @@
+/** \class HLTHtMhtTableFilter
+ *
+ * See header file for documentation
+ *
+ */
+
+#include "HLTrigger/JetMET/interface/HLTHtMhtTableFilter.h"
+
+#include <cmath>
+
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "DataFormats/Common/interface/Handle.h"
+#include "DataFormats/Common/interface/Ref.h"
+#include "DataFormats/Common/interface/RefProd.h"
+#include "DataFormats/HLTReco/interface/TriggerFilterObjectWithRefs.h"
+
+
+// Constructor
+HLTHtMhtTableFilter::HLTHtMhtTableFilter(const edm::ParameterSet & iConfig) : HLTFilter(iConfig),
+  minPtJetHt_  ( iConfig.getParameter<std::vector<double> >("minPtJetHt") ),
+  minPtJetMht_ ( iConfig.getParameter<std::vector<double> >("minPtJetMht") ),
+  minNJetHt_   ( iConfig.getParameter<std::vector<int> >("minNJetHt") ),
+  minNJetMht_  ( iConfig.getParameter<std::vector<int> >("minNJetMht") ),
+  minHt_       ( iConfig.getParameter<std::vector<double> >("minHt") ),
+  minMht_      ( iConfig.getParameter<std::vector<double> >("minMht") ),
+  minMeff_     ( iConfig.getParameter<std::vector<double> >("minMeff") ),
+  meffSlope_   ( iConfig.getParameter<std::vector<double> >("meffSlope") ),
+  htLabels_    ( iConfig.getParameter<std::vector<edm::InputTag> >("htLabels") ),
+  mhtLabels_   ( iConfig.getParameter<std::vector<edm::InputTag> >("mhtLabels") ),
+  nOrs_        ( htLabels_.size() ),  // number of settings to .OR.
+  htMhtTag_    ( iConfig.getParameter<std::string>("@module_label") ) {
+    if (!( htLabels_.size() == minPtJetHt_.size() &&
+           htLabels_.size() == minPtJetMht_.size() &&
+           htLabels_.size() == minNJetHt_.size() &&
+           htLabels_.size() == minNJetMht_.size() &&
+           htLabels_.size() == minHt_.size() &&
+           htLabels_.size() == minMht_.size() &&
+           htLabels_.size() == minMeff_.size() &&
+           htLabels_.size() == meffSlope_.size() &&
+           htLabels_.size() == mhtLabels_.size() ) ||
+        htLabels_.size() == 0 ) {
+        nOrs_ = (minPtJetHt_.size()  < nOrs_ ? minPtJetHt_.size()  : nOrs_);
+        nOrs_ = (minPtJetMht_.size() < nOrs_ ? minPtJetMht_.size() : nOrs_);
+        nOrs_ = (minNJetHt_.size()   < nOrs_ ? minNJetHt_.size()   : nOrs_);
+        nOrs_ = (minNJetMht_.size()  < nOrs_ ? minNJetMht_.size()  : nOrs_);
+        nOrs_ = (minHt_.size()       < nOrs_ ? minHt_.size()       : nOrs_);
+        nOrs_ = (minMht_.size()      < nOrs_ ? minMht_.size()      : nOrs_);
+        nOrs_ = (minMeff_.size()     < nOrs_ ? minMeff_.size()     : nOrs_);
+        nOrs_ = (meffSlope_.size()   < nOrs_ ? meffSlope_.size()   : nOrs_);
+        nOrs_ = (mhtLabels_.size()   < nOrs_ ? mhtLabels_.size()   : nOrs_);
+        edm::LogError("HLTHtMhtTableFilter") << "inconsistent module configuration!";
+    }
+
+    for(unsigned int i=0; i<nOrs_; ++i) {
+        m_theHtToken.push_back(consumes<HtMhtTable>(htLabels_[i]));
+        m_theMhtToken.push_back(consumes<HtMhtTable>(mhtLabels_[i]));
+    }
+
+    // HT and MHT objects of each set, in this order
+    produces<reco::METCollection>();
+
+}
+
+// Destructor
+HLTHtMhtTableFilter::~HLTHtMhtTableFilter() {}
+
+// Fill descriptions
+void HLTHtMhtTableFilter::fillDescriptions(edm::ConfigurationDescriptions & descriptions) {
+    // Current default is for hltHtMht
+    std::vector<edm::InputTag> tmp1(1, edm::InputTag("hltHtMhtTableProducer"));
+    std::vector<double>        tmp2(1, 0.);
+    std::vector<int>           tmp3(1, 0);
+    edm::ParameterSetDescription desc;
+    makeHLTFilterDescription(desc);
+    desc.add<std::vector<edm::InputTag> >("htLabels",  tmp1);
+    desc.add<std::vector<edm::InputTag> >("mhtLabels", tmp1);
+    tmp2[0] =  40; desc.add<std::vector<double> >("minPtJetHt",  tmp2);
+    tmp2[0] =  30; desc.add<std::vector<double> >("minPtJetMht", tmp2);
+    desc.add<std::vector<int> >("minNJetHt",  tmp3);
+    desc.add<std::vector<int> >("minNJetMht", tmp3);
+    tmp2[0] = 250; desc.add<std::vector<double> >("minHt",     tmp2);
+    tmp2[0] =  70; desc.add<std::vector<double> >("minMht",    tmp2);
+    tmp2[0] =   0; desc.add<std::vector<double> >("minMeff",   tmp2);
+    tmp2[0] =   1; desc.add<std::vector<double> >("meffSlope", tmp2);
+    descriptions.add("hltHtMhtTableFilter", desc);
+}
+
+// Make filter decision
+bool HLTHtMhtTableFilter::hltFilter(edm::Event & iEvent, const edm::EventSetup & iSetup, trigger::TriggerFilterObjectWithRefs & filterproduct) const {
+
+    bool accept = false;
+
+    // The tables are not reco::MET objects: the HT and MHT of each set are stored as
+    // reco::MET objects by this module, as HLTHtMhtProducer would have built them
+    std::auto_ptr<reco::METCollection> htmht(new reco::METCollection());
+    edm::RefProd<reco::METCollection> htmhtRefProd = iEvent.getRefBeforePut<reco::METCollection>();
+    if (saveTags())
+      filterproduct.addCollectionTag(htMhtTag_);
+
+    // Take the .OR. of all sets of requirements
+    for (unsigned int i = 0; i < nOrs_; ++i) {
+      edm::Handle<HtMhtTable> hht;
+      iEvent.getByToken(m_theHtToken[i], hht);
+      double ht = 0;
+      if ((int) hht->nJets(minPtJetHt_[i]) >= minNJetHt_[i])  ht = hht->ht(minPtJetHt_[i]);
+
+      edm::Handle<HtMhtTable> hmht;
+      iEvent.getByToken(m_theMhtToken[i], hmht);
+      double mht = 0, mhx = 0, mhy = 0, mhtHt = 0;
+      if ((int) hmht->nJets(minPtJetMht_[i]) >= minNJetMht_[i]) {
+        mht = hmht->mht(minPtJetMht_[i]);
+        mhx = hmht->mhx(minPtJetMht_[i]);
+        mhy = hmht->mhy(minPtJetMht_[i]);
+        mhtHt = hmht->ht(minPtJetMht_[i]);
+      }
+
+      // Check if the event passes this cut set
+      accept = accept || (ht > minHt_[i] && mht > minMht_[i] && sqrt(mht + meffSlope_[i]*ht) > minMeff_[i]);
+
+      // Store the objects that were cut on and the refs to them
+      // (even if they are not accepted)
+      reco::MET::Point vtx(0, 0, 0);
+      htmht->push_back(reco::MET(ht,    reco::MET::LorentzVector(mhx, mhy, 0, mht), vtx));
+      htmht->push_back(reco::MET(mhtHt, reco::MET::LorentzVector(mhx, mhy, 0, mht), vtx));
+      filterproduct.addObject(trigger::TriggerTHT, edm::Ref<reco::METCollection>(htmhtRefProd, 2*i));    // save as TriggerTHT object
+      filterproduct.addObject(trigger::TriggerMHT, edm::Ref<reco::METCollection>(htmhtRefProd, 2*i+1));  // save as TriggerMHT object
+    }
+
+    iEvent.put(htmht);
+    return accept;
+}
@@ -0,0 +1,83 @@
+/** \class HLTHtMhtTableProducer
+ *
+ * See header file for documentation
+ *
+ */
+
+#include "HLTrigger/JetMET/interface/HLTHtMhtTableProducer.h"
+#include "HLTrigger/JetMET/interface/HtMhtTable.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "DataFormats/Common/interface/Handle.h"
+
+
+namespace {
+    struct JetPt {
+        double pt, px, py;
+        bool operator<(const JetPt & other) const { return pt > other.pt; }  // decreasing pt
+    };
+}
+
+// Constructor
+HLTHtMhtTableProducer::HLTHtMhtTableProducer(const edm::ParameterSet & iConfig) :
+  usePt_                  ( iConfig.getParameter<bool>("usePt") ),
+  maxEtaJet_              ( iConfig.getParameter<double>("maxEtaJet") ),
+  jetsLabel_              ( iConfig.getParameter<edm::InputTag>("jetsLabel") ) {
+    m_theJetToken = consumes<edm::View<reco::Jet>>(jetsLabel_);
+
+    // Register the products
+    produces<HtMhtTable>();
+}
+
+// Destructor
+HLTHtMhtTableProducer::~HLTHtMhtTableProducer() {}
+
+// Fill descriptions
+void HLTHtMhtTableProducer::fillDescriptions(edm::ConfigurationDescriptions & descriptions) {
+    edm::ParameterSetDescription desc;
+    desc.add<bool>("usePt", false);
+    desc.add<double>("maxEtaJet", 3.);
+    desc.add<edm::InputTag>("jetsLabel", edm::InputTag("hltCaloJetL1FastJetCorrected"));
+    descriptions.add("hltHtMhtTableProducer", desc);
+}
+
+// Produce the products
+void HLTHtMhtTableProducer::produce(edm::Event& iEvent, const edm::EventSetup& iSetup) {
+
+    edm::Handle<reco::JetView> jets;
+    iEvent.getByToken(m_theJetToken, jets);
+
+    // Jets in the acceptance, with the same pt, px, py as in HLTHtMhtProducer
+    std::vector<JetPt> accepted;
+    accepted.reserve(jets->size());
+    for(reco::JetView::const_iterator j = jets->begin(); j != jets->end(); ++j) {
+        if (std::abs(j->eta()) < maxEtaJet_) {
+            JetPt jet;
+            if (usePt_) {
+                jet.pt = j->pt();
+                jet.px = j->px();
+                jet.py = j->py();
+            } else {
+                double phi = j->phi();
+                jet.pt = j->et();
+                jet.px = j->et() * cos(phi);
+                jet.py = j->et() * sin(phi);
+            }
+            accepted.push_back(jet);
+        }
+    }
+    std::stable_sort(accepted.begin(), accepted.end());
+
+    std::auto_ptr<HtMhtTable> result(new HtMhtTable(usePt_, maxEtaJet_));
+    for (unsigned int i = 0; i < accepted.size(); ++i)
+        result->addJet(accepted[i].pt, accepted[i].px, accepted[i].py);
+
+    // Put the products into the Event
+    iEvent.put(result);
+}
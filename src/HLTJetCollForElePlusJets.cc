@@ -8,7 +8,7 @@
 #include "DataFormats/RecoCandidate/interface/RecoEcalCandidate.h"
 #include "DataFormats/EgammaCandidates/interface/Electron.h"
 #include "DataFormats/EgammaReco/interface/SuperCluster.h"
-#include "TVector3.h"
+#include "HLTrigger/JetMET/interface/EtaPhiGrid.h"
 
 #include<typeinfo>
 
@@ -82,24 +82,18 @@ HLTJetCollForElePlusJets<T>::produce(edm::Event& iEvent, const edm::EventSetup&
   std::vector<edm::Ref<reco::ElectronCollection> > eleCands;
   PrevFilterOutput->getObjects(trigger::TriggerElectron,eleCands);
   
-  //prepare the collection of 3-D vector for electron momenta
-  std::vector<TVector3> ElePs;
+  //prepare the directions of the electron superclusters
+  std::vector<double> EleEta, ElePhi;
 
   if(!clusCands.empty()){ //try trigger cluster
     for(size_t candNr=0;candNr<clusCands.size();candNr++){
-      TVector3 positionVector(
-			      clusCands[candNr]->superCluster()->position().x(),
-			      clusCands[candNr]->superCluster()->position().y(),
-			      clusCands[candNr]->superCluster()->position().z());
-      ElePs.push_back(positionVector);
+      EleEta.push_back(clusCands[candNr]->superCluster()->position().eta());
+      ElePhi.push_back(clusCands[candNr]->superCluster()->position().phi());
     }
   }else if(!eleCands.empty()){ // try trigger electrons
     for(size_t candNr=0;candNr<eleCands.size();candNr++){
-      TVector3 positionVector(
-			      eleCands[candNr]->superCluster()->position().x(),
-			      eleCands[candNr]->superCluster()->position().y(),
-			      eleCands[candNr]->superCluster()->position().z());
-      ElePs.push_back(positionVector);
+      EleEta.push_back(eleCands[candNr]->superCluster()->position().eta());
+      ElePhi.push_back(eleCands[candNr]->superCluster()->position().phi());
     }
   }
   
@@ -114,29 +108,34 @@ HLTJetCollForElePlusJets<T>::produce(edm::Event& iEvent, const edm::EventSetup&
   
   bool foundSolution(false);
 
-  for (unsigned int i = 0; i < ElePs.size(); i++) {
+  // jets in eta-phi cells of size minDeltaR
+  EtaPhiGrid jetGrid(minDeltaR_);
+  for (unsigned int j = 0; j < theJetCollection.size(); j++) jetGrid.add(theJetCollection[j].eta(), theJetCollection[j].phi());
+  jetGrid.build();
+  std::vector<unsigned int> cleanJets, vetoedJets;
+
+  for (unsigned int i = 0; i < EleEta.size(); i++) {
     
     bool VBFJetPair = false;
     std::vector<int> store_jet;
     TRefVector refVector;
+
+    // jets farther than minDeltaR from the electron
+    jetGrid.outside(EleEta[i], ElePhi[i], cleanJets, vetoedJets);
     
-    for (unsigned int j = 0; j < theJetCollection.size(); j++) {
-      TVector3 JetP(theJetCollection[j].px(), theJetCollection[j].py(),
-                    theJetCollection[j].pz());
-      double DR = ElePs[i].DeltaR(JetP);
+    for (unsigned int jc = 0; jc < cleanJets.size(); jc++) {
+      const T & jet = theJetCollection[cleanJets[jc]];
       
-      if (JetP.Pt() > minJetPt_ && std::abs(JetP.Eta()) < maxAbsJetEta_ && DR > minDeltaR_) {
-	store_jet.push_back(j);
+      if (jet.pt() > minJetPt_ && std::abs(jet.eta()) < maxAbsJetEta_) {
+	store_jet.push_back(cleanJets[jc]);
 	// The VBF part of the filter
 	if ( minDeltaEta_ > 0 ) {
-	  for ( unsigned int k = j+1; k < theJetCollection.size(); k++ ) {
-	    TVector3 SoftJetP(theJetCollection[k].px(), theJetCollection[k].py(),
-			      theJetCollection[k].pz());
-	    double softDR = ElePs[i].DeltaR(SoftJetP);
+	  for ( unsigned int kc = jc+1; kc < cleanJets.size(); kc++ ) {
+	    const T & softJet = theJetCollection[cleanJets[kc]];
 	    
-	    if (SoftJetP.Pt() > minSoftJetPt_ && std::abs(SoftJetP.Eta()) < maxAbsJetEta_ && softDR > minDeltaR_)
-	      if ( std::abs(SoftJetP.Eta() - JetP.Eta()) > minDeltaEta_ ) {
-		store_jet.push_back(k);
+	    if (softJet.pt() > minSoftJetPt_ && std::abs(softJet.eta()) < maxAbsJetEta_)
+	      if ( std::abs(softJet.eta() - jet.eta()) > minDeltaEta_ ) {
+		store_jet.push_back(cleanJets[kc]);
 		VBFJetPair = true;
 	      }
 	  }
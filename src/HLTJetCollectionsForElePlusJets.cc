@@ -10,7 +10,7 @@
 #include "DataFormats/Common/interface/Handle.h"
 
 #include "DataFormats/EgammaReco/interface/SuperCluster.h"
-#include "TVector3.h"
+#include "HLTrigger/JetMET/interface/EtaPhiGrid.h"
 
 #include <string>
 #include <vector>
@@ -88,24 +88,18 @@ HLTJetCollectionsForElePlusJets<T>::produce(edm::Event& iEvent, const edm::Event
   std::vector<edm::Ref<reco::ElectronCollection> > eleCands;
   PrevFilterOutput->getObjects(trigger::TriggerElectron,eleCands);
   
-  //prepare the collection of 3-D vector for electron momenta
-  std::vector<TVector3> ElePs;
+  //prepare the directions of the electron superclusters
+  std::vector<double> EleEta, ElePhi;
 
   if(!clusCands.empty()){ //try trigger cluster
     for(size_t candNr=0;candNr<clusCands.size();candNr++){
-      TVector3 positionVector(
-                  clusCands[candNr]->superCluster()->position().x(),
-                  clusCands[candNr]->superCluster()->position().y(),
-                  clusCands[candNr]->superCluster()->position().z());
-      ElePs.push_back(positionVector);
+      EleEta.push_back(clusCands[candNr]->superCluster()->position().eta());
+      ElePhi.push_back(clusCands[candNr]->superCluster()->position().phi());
     }
   }else if(!eleCands.empty()){ // try trigger electrons
     for(size_t candNr=0;candNr<eleCands.size();candNr++){
-      TVector3 positionVector(
-                  eleCands[candNr]->superCluster()->position().x(),
-                  eleCands[candNr]->superCluster()->position().y(),
-                  eleCands[candNr]->superCluster()->position().z());
-      ElePs.push_back(positionVector);
+      EleEta.push_back(eleCands[candNr]->superCluster()->position().eta());
+      ElePhi.push_back(eleCands[candNr]->superCluster()->position().phi());
     }
   }
   
@@ -120,19 +114,22 @@ HLTJetCollectionsForElePlusJets<T>::produce(edm::Event& iEvent, const edm::Event
   
  //bool foundSolution(false);
 
-    for (unsigned int i = 0; i < ElePs.size(); i++) {
+    // jets in eta-phi cells of size minDeltaR
+    EtaPhiGrid jetGrid(minDeltaR_);
+    for (unsigned int j = 0; j < theJetCollection.size(); j++) jetGrid.add(theJetCollection[j].eta(), theJetCollection[j].phi());
+    jetGrid.build();
+    std::vector<unsigned int> cleanJets, vetoedJets;
+
+    for (unsigned int i = 0; i < EleEta.size(); i++) {
 
        // bool VBFJetPair = false;
         //std::vector<int> store_jet;
         TRefVector refVector;
 
-        for (unsigned int j = 0; j < theJetCollection.size(); j++) {
-            TVector3 JetP(theJetCollection[j].px(), theJetCollection[j].py(), theJetCollection[j].pz());
-            double DR = ElePs[i].DeltaR(JetP);
-
-            if (DR > minDeltaR_)
-        refVector.push_back(TRef(theJetCollectionHandle, j));
-        }
+        // jets farther than minDeltaR from the electron
+        jetGrid.outside(EleEta[i], ElePhi[i], cleanJets, vetoedJets);
+        for (unsigned int j = 0; j < cleanJets.size(); j++)
+        refVector.push_back(TRef(theJetCollectionHandle, cleanJets[j]));
     allSelections->push_back(refVector);
     }
 
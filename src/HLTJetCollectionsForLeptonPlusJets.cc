@@ -12,7 +12,7 @@
 #include "DataFormats/Common/interface/Handle.h"
 
 #include "DataFormats/EgammaReco/interface/SuperCluster.h"
-#include "DataFormats/Math/interface/deltaR.h"
+#include "HLTrigger/JetMET/interface/EtaPhiGrid.h"
 
 
 
@@ -87,13 +87,18 @@ HLTJetCollectionsForLeptonPlusJets<jetType>::produce(edm::Event& iEvent, const e
   const JetCollection & theJetCollection = *theJetCollectionHandle;
   
   auto_ptr < JetCollectionVector > allSelections(new JetCollectionVector());
+
+  // jets in eta-phi cells of size minDeltaR
+  EtaPhiGrid jetGrid(minDeltaR_);
+  for (unsigned int j = 0; j < theJetCollection.size(); j++) jetGrid.add(theJetCollection[j].eta(), theJetCollection[j].phi());
+  jetGrid.build();
+  vector<unsigned int> cleanJets, vetoedJets;
   
  if(!clusCands.empty()){ //try trigger cluster
     for(size_t candNr=0;candNr<clusCands.size();candNr++){  
         JetRefVector refVector;
-        for (unsigned int j = 0; j < theJetCollection.size(); j++) {
-          if (deltaR(clusCands[candNr]->superCluster()->position(),theJetCollection[j]) > minDeltaR_) refVector.push_back(JetRef(theJetCollectionHandle, j));
-        }
+        jetGrid.outside(clusCands[candNr]->superCluster()->position().eta(),clusCands[candNr]->superCluster()->position().phi(),cleanJets,vetoedJets);
+        for (unsigned int j = 0; j < cleanJets.size(); j++) refVector.push_back(JetRef(theJetCollectionHandle, cleanJets[j]));
     allSelections->push_back(refVector);
     }
  }
@@ -101,9 +106,8 @@ HLTJetCollectionsForLeptonPlusJets<jetType>::produce(edm::Event& iEvent, const e
  if(!eleCands.empty()){ //try trigger cluster
     for(size_t candNr=0;candNr<eleCands.size();candNr++){  
         JetRefVector refVector;
-        for (unsigned int j = 0; j < theJetCollection.size(); j++) {
-          if (deltaR(eleCands[candNr]->superCluster()->position(),theJetCollection[j]) > minDeltaR_) refVector.push_back(JetRef(theJetCollectionHandle, j));
-        }
+        jetGrid.outside(eleCands[candNr]->superCluster()->position().eta(),eleCands[candNr]->superCluster()->position().phi(),cleanJets,vetoedJets);
+        for (unsigned int j = 0; j < cleanJets.size(); j++) refVector.push_back(JetRef(theJetCollectionHandle, cleanJets[j]));
     allSelections->push_back(refVector);
     }
  }
@@ -111,9 +115,8 @@ HLTJetCollectionsForLeptonPlusJets<jetType>::produce(edm::Event& iEvent, const e
  if(!muonCands.empty()){ //try trigger cluster
     for(size_t candNr=0;candNr<muonCands.size();candNr++){  
         JetRefVector refVector;
-        for (unsigned int j = 0; j < theJetCollection.size(); j++) {
-	  if (deltaR(muonCands[candNr]->p4(),theJetCollection[j]) > minDeltaR_) refVector.push_back(JetRef(theJetCollectionHandle, j));
-        }
+        jetGrid.outside(muonCands[candNr]->eta(),muonCands[candNr]->phi(),cleanJets,vetoedJets);
+        for (unsigned int j = 0; j < cleanJets.size(); j++) refVector.push_back(JetRef(theJetCollectionHandle, cleanJets[j]));
     allSelections->push_back(refVector);
     }
  }
@@ -0,0 +1,53 @@
+/** \class HLTJetKinematicsProducer
+ *
+ * See header file for documentation
+ *
+ */
+
+#include "HLTrigger/JetMET/interface/HLTJetKinematicsProducer.h"
+#include "HLTrigger/JetMET/interface/JetKinematics.h"
+
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "DataFormats/Common/interface/Handle.h"
+
+
+// Constructor
+HLTJetKinematicsProducer::HLTJetKinematicsProducer(const edm::ParameterSet & iConfig) :
+  minPt_                  ( iConfig.getParameter<double>("minPt") ),
+  jetsLabel_              ( iConfig.getParameter<edm::InputTag>("jetsLabel") ) {
+    m_theJetToken = consumes<edm::View<reco::Jet>>(jetsLabel_);
+
+    // Register the products
+    produces<JetKinematics>();
+}
+
+// Destructor
+HLTJetKinematicsProducer::~HLTJetKinematicsProducer() {}
+
+// Fill descriptions
+void HLTJetKinematicsProducer::fillDescriptions(edm::ConfigurationDescriptions & descriptions) {
+    edm::ParameterSetDescription desc;
+    desc.add<double>("minPt", -1.);
+    desc.add<edm::InputTag>("jetsLabel", edm::InputTag("hltAK4PFJetL1FastL2L3Corrected"));
+    descriptions.add("hltJetKinematicsProducer", desc);
+}
+
+// Produce the products
+void HLTJetKinematicsProducer::produce(edm::Event& iEvent, const edm::EventSetup& iSetup) {
+
+    edm::Handle<reco::JetView> jets;
+    iEvent.getByToken(m_theJetToken, jets);
+
+    std::auto_ptr<JetKinematics> result(new JetKinematics(minPt_));
+    result->reserve(jets->size());
+    for (unsigned int i = 0; i < jets->size(); ++i) {
+        const reco::Jet & jet = (*jets)[i];
+        if (minPt_ < 0 || jet.pt() > minPt_)
+            result->push_back(jet, i);
+    }
+
+    // Put the products into the Event
+    iEvent.put(result);
+}
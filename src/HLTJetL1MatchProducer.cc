@@ -10,20 +10,25 @@
 #include<string>
 
 template<typename T>
-HLTJetL1MatchProducer<T>::HLTJetL1MatchProducer(const edm::ParameterSet& iConfig)
+HLTJetL1MatchProducer<T>::HLTJetL1MatchProducer(const edm::ParameterSet& iConfig) :
+  DeltaR_(iConfig.template getParameter<double>("DeltaR")),
+  produceRefs_(iConfig.template getParameter<bool>("produceRefs")),
+  l1Grid_(DeltaR_)
 {
   jetsInput_ = iConfig.template getParameter<edm::InputTag>("jetsInput");
   L1TauJets_ = iConfig.template getParameter<edm::InputTag>("L1TauJets");
   L1CenJets_ = iConfig.template getParameter<edm::InputTag>("L1CenJets");
   L1ForJets_ = iConfig.template getParameter<edm::InputTag>("L1ForJets");
-  DeltaR_ = iConfig.template getParameter<double>("DeltaR");
 
   typedef std::vector<T> TCollection;
   m_theJetToken = consumes<TCollection>(jetsInput_);
   m_theL1TauJetToken = consumes<l1extra::L1JetParticleCollection>(L1TauJets_);
   m_theL1CenJetToken = consumes<l1extra::L1JetParticleCollection>(L1CenJets_);
   m_theL1ForJetToken = consumes<l1extra::L1JetParticleCollection>(L1ForJets_);
-  produces<TCollection> ();
+  if (produceRefs_)
+    produces<edm::RefVector<TCollection> > ();
+  else
+    produces<TCollection> ();
 
 }
 
@@ -47,6 +52,7 @@ void HLTJetL1MatchProducer<T>::fillDescriptions(edm::ConfigurationDescriptions&
   desc.add<edm::InputTag>("L1CenJets",edm::InputTag("hltL1extraParticles","Central"));
   desc.add<edm::InputTag>("L1ForJets",edm::InputTag("hltL1extraParticles","Forward"));
   desc.add<double>("DeltaR",0.5);
+  desc.add<bool>("produceRefs",false);
   descriptions.add(std::string("hlt")+std::string(typeid(HLTJetL1MatchProducer<T>).name()),desc);
 }
 
@@ -59,9 +65,6 @@ void HLTJetL1MatchProducer<T>::produce(edm::Event& iEvent, const edm::EventSetup
   edm::Handle<TCollection> jets;
   iEvent.getByToken(m_theJetToken, jets);
 
-  std::auto_ptr<TCollection> result (new TCollection);
-
-
   edm::Handle<l1extra::L1JetParticleCollection> l1TauJets;
   iEvent.getByToken(m_theL1TauJetToken,l1TauJets);
 
@@ -71,41 +74,30 @@ void HLTJetL1MatchProducer<T>::produce(edm::Event& iEvent, const edm::EventSetup
   edm::Handle<l1extra::L1JetParticleCollection> l1ForJets;
   iEvent.getByToken(m_theL1ForJetToken,l1ForJets);
 
-  typename TCollection::const_iterator jet_iter;
-  for (jet_iter = jets->begin(); jet_iter != jets->end(); ++jet_iter) {
-
-    bool isMatched=false;
-
-    //std::cout << "FL: l1TauJets.size  = " << l1TauJets->size() << std::endl;
-    for (unsigned int jetc=0;jetc<l1TauJets->size();++jetc)
-    {
-      const double deltaeta=jet_iter->eta()-(*l1TauJets)[jetc].eta();
-      const double deltaphi=deltaPhi(jet_iter->phi(),(*l1TauJets)[jetc].phi());
-      //std::cout << "FL: sqrt(2) = " << sqrt(2) << std::endl;
-      if (sqrt(deltaeta*deltaeta+deltaphi*deltaphi) < DeltaR_) isMatched=true;
-    }
-
-    for (unsigned int jetc=0;jetc<l1CenJets->size();++jetc)
-    {
-      const double deltaeta=jet_iter->eta()-(*l1CenJets)[jetc].eta();
-      const double deltaphi=deltaPhi(jet_iter->phi(),(*l1CenJets)[jetc].phi());
-      if (sqrt(deltaeta*deltaeta+deltaphi*deltaphi) < DeltaR_) isMatched=true;
-    }
-
-    for (unsigned int jetc=0;jetc<l1ForJets->size();++jetc)
-    {
-      const double deltaeta=jet_iter->eta()-(*l1ForJets)[jetc].eta();
-      const double deltaphi=deltaPhi(jet_iter->phi(),(*l1ForJets)[jetc].phi());
-      if (sqrt(deltaeta*deltaeta+deltaphi*deltaphi) < DeltaR_) isMatched=true;
+  // all L1 jets, in eta-phi cells of size DeltaR
+  l1Grid_.clear();
+  for (unsigned int jetc=0;jetc<l1TauJets->size();++jetc)
+    l1Grid_.add((*l1TauJets)[jetc].eta(),(*l1TauJets)[jetc].phi());
+  for (unsigned int jetc=0;jetc<l1CenJets->size();++jetc)
+    l1Grid_.add((*l1CenJets)[jetc].eta(),(*l1CenJets)[jetc].phi());
+  for (unsigned int jetc=0;jetc<l1ForJets->size();++jetc)
+    l1Grid_.add((*l1ForJets)[jetc].eta(),(*l1ForJets)[jetc].phi());
+  l1Grid_.build();
+
+  if (produceRefs_) {
+    std::auto_ptr<edm::RefVector<TCollection> > result (new edm::RefVector<TCollection>);
+    for (unsigned int i = 0; i < jets->size(); ++i) {
+      if (l1Grid_.matches((*jets)[i].eta(),(*jets)[i].phi())) result->push_back(edm::Ref<TCollection>(jets,i));
     }
-
-
-    if (isMatched==true) result->push_back(*jet_iter);
-
-  } // jet_iter
-
-  iEvent.put( result);
+    iEvent.put( result);
+  }
+  else {
+    std::auto_ptr<TCollection> result (new TCollection);
+    typename TCollection::const_iterator jet_iter;
+    for (jet_iter = jets->begin(); jet_iter != jets->end(); ++jet_iter) {
+      if (l1Grid_.matches(jet_iter->eta(),jet_iter->phi())) result->push_back(*jet_iter);
+    } // jet_iter
+    iEvent.put( result);
+  }
 
 }
-
-
@@ -18,8 +18,10 @@
 #include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 #include "FWCore/Utilities/interface/InputTag.h"
+#include "FWCore/Utilities/interface/Exception.h"
 
 #include<typeinfo>
+#include<algorithm>
 
 //
 // constructors and destructor
@@ -34,9 +36,12 @@ HLTJetVBFFilter<T>::HLTJetVBFFilter(const edm::ParameterSet& iConfig) : HLTFilte
   minInvMass_     (iConfig.template getParameter<double> ("minInvMass")),
   maxEta_         (iConfig.template getParameter<double> ("maxEta")),
   leadingJetOnly_ (iConfig.template getParameter<bool>   ("leadingJetOnly")),
-  triggerType_    (iConfig.template getParameter<int> ("triggerType"))
+  triggerType_    (iConfig.template getParameter<int> ("triggerType")),
+  jetKinematicsLabel_ (iConfig.template getParameter< edm::InputTag > ("jetKinematicsLabel")),
+  useJetKinematics_   (jetKinematicsLabel_.label() != "")
 {
   m_theObjectToken = consumes<std::vector<T>>(inputTag_);
+  if (useJetKinematics_) m_theJetKinematicsToken = consumes<JetKinematics>(jetKinematicsLabel_);
   LogDebug("") << "HLTJetVBFFilter: Input/minPtLow_/minPtHigh_/triggerType : "
 	       << inputTag_.encode() << " "
 	       << minPtLow_  << " "
@@ -61,9 +66,89 @@ HLTJetVBFFilter<T>::fillDescriptions(edm::ConfigurationDescriptions& description
   desc.add<double>("maxEta",5.0);
   desc.add<bool>("leadingJetOnly",false);
   desc.add<int>("triggerType",trigger::TriggerJet);
+  desc.add<edm::InputTag>("jetKinematicsLabel",edm::InputTag(""));
   descriptions.add(std::string("hlt")+std::string(typeid(HLTJetVBFFilter<T>).name()),desc);
 }
 
+//
+// ------------ add the pairs passing the VBF cuts  ------------
+//
+template<typename T>
+template<class C, class P>
+int
+HLTJetVBFFilter<T>::addPairs(C const & jets, unsigned int nJets, P position, edm::Handle<std::vector<T>> const & objects, trigger::TriggerFilterObjectWithRefs & filterproduct) const
+{
+  typedef edm::Ref<std::vector<T>> TRef;
+
+  int n(0);
+
+  double ejet1   = 0.;
+  double pxjet1  = 0.;
+  double pyjet1  = 0.;
+  double pzjet1  = 0.;
+  double ptjet1  = 0.;
+  double etajet1 = 0.;
+
+  double ejet2   = 0.;
+  double pxjet2  = 0.;
+  double pyjet2  = 0.;
+  double pzjet2  = 0.;
+  double ptjet2  = 0.;
+  double etajet2 = 0.;
+
+  // loop on all jets
+  for (unsigned int i1 = 0; i1 < nJets; ++i1) {
+    if( leadingJetOnly_==true && i1+1>2 ) break;
+    //
+    if( jets[i1].pt() < minPtHigh_ ) break; //No need to go to the next jet (lower PT)
+    if( std::abs(jets[i1].eta()) > maxEta_ ) continue;
+    //
+    for (unsigned int i2 = i1+1; i2 < nJets; ++i2) {
+      if( leadingJetOnly_==true && i2+1>2 ) break;
+      //
+      if( jets[i2].pt() < minPtLow_ ) break; //No need to go to the next jet (lower PT)
+      if( std::abs(jets[i2].eta()) > maxEta_ ) continue;
+      //
+      ejet1   = jets[i1].energy();
+      pxjet1  = jets[i1].px();
+      pyjet1  = jets[i1].py();
+      pzjet1  = jets[i1].pz();
+      ptjet1  = jets[i1].pt();
+      etajet1 = jets[i1].eta();
+
+      ejet2   = jets[i2].energy();
+      pxjet2  = jets[i2].px();
+      pyjet2  = jets[i2].py();
+      pzjet2  = jets[i2].pz();
+      ptjet2  = jets[i2].pt();
+      etajet2 = jets[i2].eta();
+      //
+      float deltaetajet = etajet1 - etajet2;
+      float invmassjet = sqrt( (ejet1  + ejet2)  * (ejet1  + ejet2) -
+                               (pxjet1 + pxjet2) * (pxjet1 + pxjet2) -
+                               (pyjet1 + pyjet2) * (pyjet1 + pyjet2) -
+                               (pzjet1 + pzjet2) * (pzjet1 + pzjet2) );
+
+      // VBF cuts
+      if ( (ptjet1 > minPtHigh_) &&
+           (ptjet2 > minPtLow_) &&
+           ( (etaOpposite_ == true && etajet1*etajet2 < 0) || (etaOpposite_ == false) ) &&
+           (std::abs(deltaetajet) > minDeltaEta_) &&
+           (std::abs(invmassjet) > minInvMass_) ){
+        ++n;
+        TRef ref1 = TRef(objects,position(i1));
+        TRef ref2 = TRef(objects,position(i2));
+        filterproduct.addObject(triggerType_,ref1);
+        filterproduct.addObject(triggerType_,ref2);
+      }// VBF cuts
+      //if(n>=1) break; //Store all possible pairs
+    }
+    //if(n>=1) break; //Store all possible pairs
+  }// loop on all jets
+
+  return n;
+}
+
 //
 // ------------ method called to produce the data  ------------
 //
@@ -77,7 +162,6 @@ HLTJetVBFFilter<T>::hltFilter(edm::Event& iEvent, const edm::EventSetup& iSetup,
   using namespace trigger;
 
   typedef vector<T> TCollection;
-  typedef Ref<TCollection> TRef;
 
   // The filter object
   if (saveTags()) filterproduct.addCollectionTag(inputTag_);
@@ -91,77 +175,21 @@ HLTJetVBFFilter<T>::hltFilter(edm::Event& iEvent, const edm::EventSetup& iSetup,
 
   // events with two or more jets
   if(objects->size() > 1){
-
-    double ejet1   = 0.;
-    double pxjet1  = 0.;
-    double pyjet1  = 0.;
-    double pzjet1  = 0.;
-    double ptjet1  = 0.;
-    double etajet1 = 0.;
-
-    double ejet2   = 0.;
-    double pxjet2  = 0.;
-    double pyjet2  = 0.;
-    double pzjet2  = 0.;
-    double ptjet2  = 0.;
-    double etajet2 = 0.;
-
-    // loop on all jets
-    int countJet1(0);
-    int countJet2(0);
-    typename TCollection::const_iterator jet1 ( objects->begin() );
-    for (; jet1!=objects->end(); jet1++) {
-      countJet1++;
-      if( leadingJetOnly_==true && countJet1>2 ) break;
-      //
-      if( jet1->pt() < minPtHigh_ ) break; //No need to go to the next jet (lower PT)
-      if( std::abs(jet1->eta()) > maxEta_ ) continue;
-      //
-      countJet2 = countJet1-1;
-      typename TCollection::const_iterator jet2 ( jet1+1 );
-      for (; jet2!=objects->end(); jet2++) {
-	countJet2++;
-	if( leadingJetOnly_==true && countJet2>2 ) break;
-	//
-        if( jet2->pt() < minPtLow_ ) break; //No need to go to the next jet (lower PT)
-	if( std::abs(jet2->eta()) > maxEta_ ) continue;
-	//
-        ejet1   = jet1->energy();
-        pxjet1  = jet1->px();
-        pyjet1  = jet1->py();
-        pzjet1  = jet1->pz();
-        ptjet1  = jet1->pt();
-	etajet1 = jet1->eta();
-
-        ejet2   = jet2->energy();
-        pxjet2  = jet2->px();
-        pyjet2  = jet2->py();
-        pzjet2  = jet2->pz();
-        ptjet2  = jet2->pt();
-        etajet2 = jet2->eta();
-        //
-        float deltaetajet = etajet1 - etajet2;
-        float invmassjet = sqrt( (ejet1  + ejet2)  * (ejet1  + ejet2) -
-      	                         (pxjet1 + pxjet2) * (pxjet1 + pxjet2) -
-                                 (pyjet1 + pyjet2) * (pyjet1 + pyjet2) -
-                                 (pzjet1 + pzjet2) * (pzjet1 + pzjet2) );
-
-        // VBF cuts
-        if ( (ptjet1 > minPtHigh_) &&
-	     (ptjet2 > minPtLow_) &&
-             ( (etaOpposite_ == true && etajet1*etajet2 < 0) || (etaOpposite_ == false) ) &&
-             (std::abs(deltaetajet) > minDeltaEta_) &&
-	     (std::abs(invmassjet) > minInvMass_) ){
-   	  ++n;
-          TRef ref1 = TRef(objects,distance(objects->begin(),jet1));
-	  TRef ref2 = TRef(objects,distance(objects->begin(),jet2));
-          filterproduct.addObject(triggerType_,ref1);
-          filterproduct.addObject(triggerType_,ref2);
-        }// VBF cuts
-	//if(n>=1) break; //Store all possible pairs
-      }
-      //if(n>=1) break; //Store all possible pairs
-    }// loop on all jets
+    if (useJetKinematics_) {
+      Handle<JetKinematics> jetKinematics;
+      iEvent.getByToken (m_theJetKinematicsToken,jetKinematics);
+      const JetKinematics & kin = *jetKinematics;
+      // the jets not stored must stop both loops, as jets below minPtHigh and minPtLow do
+      if (kin.preselected() && kin.minPt() >= std::min(minPtLow_, minPtHigh_))
+        throw cms::Exception("Configuration") << "HLTJetVBFFilter: JetKinematics " << jetKinematicsLabel_
+                                              << " only has the jets with pt > " << kin.minPt() << ".\n";
+      // so only the jets before the first one not stored are looked at
+      unsigned int nJets = 0;
+      while (nJets < kin.size() && kin.index()[nJets] == nJets) ++nJets;
+      n = addPairs(kin, nJets, [&kin](unsigned int i) { return kin.index()[i]; }, objects, filterproduct);
+    }
+    else
+      n = addPairs(*objects, objects->size(), [](unsigned int i) { return i; }, objects, filterproduct);
   }// events with two or more jets
 
   // filter decision
@@ -12,6 +12,7 @@
 #include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
 #include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
 #include "DataFormats/Common/interface/Handle.h"
+#include "FWCore/Utilities/interface/Exception.h"
 
 
 // Constructor
@@ -22,10 +23,16 @@ HLTMhtProducer::HLTMhtProducer(const edm::ParameterSet & iConfig) :
   minPtJet_               ( iConfig.getParameter<double>("minPtJet") ),
   maxEtaJet_              ( iConfig.getParameter<double>("maxEtaJet") ),
   jetsLabel_              ( iConfig.getParameter<edm::InputTag>("jetsLabel") ),
-  pfCandidatesLabel_      ( iConfig.getParameter<edm::InputTag>("pfCandidatesLabel") ) {
-    m_theJetToken = consumes<edm::View<reco::Jet>>(jetsLabel_);
-    if (pfCandidatesLabel_.label() == "") excludePFMuons_ = false;
-    if (excludePFMuons_) m_thePFCandidateToken = consumes<reco::PFCandidateCollection>(pfCandidatesLabel_);
+  pfCandidatesLabel_      ( iConfig.getParameter<edm::InputTag>("pfCandidatesLabel") ),
+  jetKinematicsLabel_     ( iConfig.getParameter<edm::InputTag>("jetKinematicsLabel") ),
+  useJetKinematics_       ( jetKinematicsLabel_.label() != "" ),
+  pfLightCandidatesLabel_ ( iConfig.getParameter<edm::InputTag>("pfLightCandidatesLabel") ),
+  usePFLightCandidates_   ( pfLightCandidatesLabel_.label() != "" ) {
+    if (useJetKinematics_) m_theJetKinematicsToken = consumes<JetKinematics>(jetKinematicsLabel_);
+    else m_theJetToken = consumes<edm::View<reco::Jet>>(jetsLabel_);
+    if (pfCandidatesLabel_.label() == "" && !usePFLightCandidates_) excludePFMuons_ = false;
+    if (excludePFMuons_ && usePFLightCandidates_) m_thePFLightCandidateToken = consumes<PFLightCandidates>(pfLightCandidatesLabel_);
+    else if (excludePFMuons_) m_thePFCandidateToken = consumes<reco::PFCandidateCollection>(pfCandidatesLabel_);
 
     // Register the products
     produces<reco::METCollection>();
@@ -45,9 +52,28 @@ void HLTMhtProducer::fillDescriptions(edm::ConfigurationDescriptions & descripti
     desc.add<double>("maxEtaJet", 999.);
     desc.add<edm::InputTag>("jetsLabel", edm::InputTag("hltAntiKT4PFJets"));
     desc.add<edm::InputTag>("pfCandidatesLabel",  edm::InputTag("hltParticleFlow"));
+    desc.add<edm::InputTag>("pfLightCandidatesLabel",  edm::InputTag(""));
+    desc.add<edm::InputTag>("jetKinematicsLabel",  edm::InputTag(""));
     descriptions.add("hltMhtProducer", desc);
 }
 
+// Add a jet to the sums
+template <class J>
+void HLTMhtProducer::addJet(J const & jet, int & nj, double & sumet, double & mhx, double & mhy) const {
+    double pt = usePt_ ? jet.pt() : jet.et();
+    double eta = jet.eta();
+    double phi = jet.phi();
+    double px = usePt_ ? jet.px() : jet.et() * cos(phi);
+    double py = usePt_ ? jet.py() : jet.et() * sin(phi);
+
+    if (pt > minPtJet_ && std::abs(eta) < maxEtaJet_) {
+        mhx -= px;
+        mhy -= py;
+        sumet += pt;
+        ++nj;
+    }
+}
+
 // Produce the products
 void HLTMhtProducer::produce(edm::Event& iEvent, const edm::EventSetup& iSetup) {
 
@@ -55,33 +81,43 @@ void HLTMhtProducer::produce(edm::Event& iEvent, const edm::EventSetup& iSetup)
     std::auto_ptr<reco::METCollection> result(new reco::METCollection());
 
     edm::Handle<reco::JetView> jets;
-    iEvent.getByToken(m_theJetToken, jets);
+    edm::Handle<JetKinematics> jetKinematics;
+    if (useJetKinematics_)
+        iEvent.getByToken(m_theJetKinematicsToken, jetKinematics);
+    else
+        iEvent.getByToken(m_theJetToken, jets);
 
     edm::Handle<reco::PFCandidateCollection> pfCandidates;
-    if (excludePFMuons_)
+    edm::Handle<PFLightCandidates> pfLightCandidates;
+    if (excludePFMuons_ && usePFLightCandidates_)
+        iEvent.getByToken(m_thePFLightCandidateToken, pfLightCandidates);
+    else if (excludePFMuons_)
         iEvent.getByToken(m_thePFCandidateToken, pfCandidates);
 
     int nj = 0;
     double sumet = 0., mhx = 0., mhy = 0.;
 
-    if (jets->size() > 0) {
-        for(reco::JetView::const_iterator j = jets->begin(); j != jets->end(); ++j) {
-            double pt = usePt_ ? j->pt() : j->et();
-            double eta = j->eta();
-            double phi = j->phi();
-            double px = usePt_ ? j->px() : j->et() * cos(phi);
-            double py = usePt_ ? j->py() : j->et() * sin(phi);
-
-            if (pt > minPtJet_ && std::abs(eta) < maxEtaJet_) {
-                mhx -= px;
-                mhy -= py;
-                sumet += pt;
-                ++nj;
-            }
-        }
+    if (useJetKinematics_) {
+        const JetKinematics & kin = *jetKinematics;
+        // the jets not stored must fail the pt requirement
+        if (kin.preselected() && (!usePt_ || kin.minPt() > minPtJet_))
+            throw cms::Exception("Configuration") << "HLTMhtProducer: JetKinematics " << jetKinematicsLabel_
+                                                  << " only has the jets with pt > " << kin.minPt() << ".\n";
+        for (unsigned int j = 0; j < kin.size(); ++j)
+            addJet(kin[j], nj, sumet, mhx, mhy);
+
+    } else if (jets->size() > 0) {
+        for(reco::JetView::const_iterator j = jets->begin(); j != jets->end(); ++j)
+            addJet(*j, nj, sumet, mhx, mhy);
     }
 
-    if (excludePFMuons_) {
+    if (excludePFMuons_ && usePFLightCandidates_) {
+        const std::vector<unsigned int> & muons = pfLightCandidates->muons();
+        for (unsigned int i = 0; i < muons.size(); ++i) {
+            mhx += pfLightCandidates->px()[muons[i]];
+            mhy += pfLightCandidates->py()[muons[i]];
+        }
+    } else if (excludePFMuons_) {
         for (reco::PFCandidateCollection::const_iterator j = pfCandidates->begin(); j != pfCandidates->end(); ++j) {
             if (std::abs(j->pdgId()) == 13) {
                 mhx += j->px();
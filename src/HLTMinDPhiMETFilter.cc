@@ -14,6 +14,7 @@
 //#include "DataFormats/HLTReco/interface/TriggerTypeDefs.h"
 //#include "DataFormats/HLTReco/interface/TriggerFilterObjectWithRefs.h"
 #include "DataFormats/Math/interface/deltaPhi.h"
+#include "FWCore/Utilities/interface/Exception.h"
 
 
 // Constructor
@@ -27,10 +28,13 @@ HLTMinDPhiMETFilter::HLTMinDPhiMETFilter(const edm::ParameterSet& iConfig) : HLT
   minDPhi_        (iConfig.getParameter<double>("minDPhi")),
   metLabel_       (iConfig.getParameter<edm::InputTag>("metLabel")),
   calometLabel_   (iConfig.getParameter<edm::InputTag>("calometLabel")),
-  jetsLabel_      (iConfig.getParameter<edm::InputTag>("jetsLabel")) {
+  jetsLabel_      (iConfig.getParameter<edm::InputTag>("jetsLabel")),
+  jetKinematicsLabel_ (iConfig.getParameter<edm::InputTag>("jetKinematicsLabel")),
+  useJetKinematics_   (jetKinematicsLabel_.label() != "") {
     m_theMETToken = consumes<reco::METCollection>(metLabel_);
     m_theCaloMETToken = consumes<reco::CaloMETCollection>(calometLabel_);
-    m_theJetToken = consumes<reco::JetView>(jetsLabel_);
+    if (useJetKinematics_) m_theJetKinematicsToken = consumes<JetKinematics>(jetKinematicsLabel_);
+    else m_theJetToken = consumes<reco::JetView>(jetsLabel_);
 }
 
 // Destructor
@@ -50,9 +54,24 @@ void HLTMinDPhiMETFilter::fillDescriptions(edm::ConfigurationDescriptions& descr
     desc.add<edm::InputTag>("metLabel", edm::InputTag("hltPFMETProducer"));
     desc.add<edm::InputTag>("calometLabel", edm::InputTag(""));
     desc.add<edm::InputTag>("jetsLabel", edm::InputTag("hltAK4PFJetL1FastL2L3Corrected"));
+    desc.add<edm::InputTag>("jetKinematicsLabel", edm::InputTag(""));
     descriptions.add("hltMinDPhiMETFilter", desc);
 }
 
+// Update the min delta phi with a jet
+template <class J>
+void HLTMinDPhiMETFilter::updateMinDPhi(J const & jet, double metphi, double & minDPhi) const {
+    double pt = usePt_ ? jet.pt() : jet.et();
+    double eta = jet.eta();
+    double phi = jet.phi();
+    if (pt > minPt_ && std::abs(eta) < maxEta_) {
+        double dPhi = std::abs(reco::deltaPhi(metphi, phi));
+        if (minDPhi > dPhi) {
+            minDPhi = dPhi;
+        }
+    }
+}
+
 // Make filter decision
 bool HLTMinDPhiMETFilter::hltFilter(edm::Event& iEvent, const edm::EventSetup& iSetup, trigger::TriggerFilterObjectWithRefs & filterproduct) const {
 
@@ -70,31 +89,44 @@ bool HLTMinDPhiMETFilter::hltFilter(edm::Event& iEvent, const edm::EventSetup& i
     }
 
     edm::Handle<reco::JetView> jets;  // assume to be sorted by pT
-    iEvent.getByToken(m_theJetToken, jets);
+    edm::Handle<JetKinematics> jetKinematics;
+    if (useJetKinematics_) {
+        iEvent.getByToken(m_theJetKinematicsToken, jetKinematics);
+        // the jets not stored must fail the pt requirement
+        if (jetKinematics->preselected() && (!usePt_ || jetKinematics->minPt() > minPt_))
+            throw cms::Exception("Configuration") << "HLTMinDPhiMETFilter: JetKinematics " << jetKinematicsLabel_
+                                                  << " only has the jets with pt > " << jetKinematics->minPt() << ".\n";
+    } else
+        iEvent.getByToken(m_theJetToken, jets);
 
     double minDPhi = 3.141593;
     int nJets = 0;  // nJets counts all jets in the events, not only those that pass pt, eta requirements
 
-    if (jets->size() > 0 &&
+    if (useJetKinematics_ && jetKinematics->size() > 0 &&
+        ((usePFMET ? mets->size() : calomets->size()) > 0) ) {
+        double metphi = usePFMET ? mets->front().phi() : calomets->front().phi();
+        const JetKinematics & kin = *jetKinematics;
+        for (unsigned int j = 0; j < kin.size(); ++j) {
+            // the position in the jet collection also counts the jets that were not stored
+            nJets = kin.index()[j];
+            if (nJets >= maxNJets_)
+                break;
+
+            updateMinDPhi(kin[j], metphi, minDPhi);
+        }
+
+    } else if (!useJetKinematics_ && jets->size() > 0 &&
         ((usePFMET ? mets->size() : calomets->size()) > 0) ) {
         double metphi = usePFMET ? mets->front().phi() : calomets->front().phi();
         for (reco::JetView::const_iterator j = jets->begin(); j != jets->end(); ++j) {
             if (nJets >= maxNJets_)
                 break;
 
-            double pt = usePt_ ? j->pt() : j->et();
-            double eta = j->eta();
-            double phi = j->phi();
-            if (pt > minPt_ && std::abs(eta) < maxEta_) {
-                double dPhi = std::abs(reco::deltaPhi(metphi, phi));
-                if (minDPhi > dPhi) {
-                    minDPhi = dPhi;
-                }
-
-                // Not sure what to save, since an event quantity is used
-                //reco::JetBaseRef ref(jets, distance(jets->begin(), j));
-                //filterproduct.addObject(triggerType_, ref);
-            }
+            updateMinDPhi(*j, metphi, minDPhi);
+
+            // Not sure what to save, since an event quantity is used
+            //reco::JetBaseRef ref(jets, distance(jets->begin(), j));
+            //filterproduct.addObject(triggerType_, ref);
 
             ++nJets;
         }
@@ -18,6 +18,7 @@
 #include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 #include "FWCore/Utilities/interface/InputTag.h"
+#include "FWCore/Utilities/interface/Exception.h"
 
 #include<typeinfo>
 
@@ -29,9 +30,12 @@ HLTMonoJetFilter<T>::HLTMonoJetFilter(const edm::ParameterSet& iConfig) : HLTFil
   inputJetTag_    (iConfig.template getParameter< edm::InputTag > ("inputJetTag")),
   maxPtSecondJet_ (iConfig.template getParameter<double> ("maxPtSecondJet")),
   maxDeltaPhi_    (iConfig.template getParameter<double> ("maxDeltaPhi")),
-  triggerType_    (iConfig.template getParameter<int> ("triggerType"))
+  triggerType_    (iConfig.template getParameter<int> ("triggerType")),
+  jetKinematicsLabel_ (iConfig.template getParameter< edm::InputTag > ("jetKinematicsLabel")),
+  useJetKinematics_   (jetKinematicsLabel_.label() != "")
 {
   m_theObjectToken = consumes<std::vector<T>>(inputJetTag_);
+  if (useJetKinematics_) m_theJetKinematicsToken = consumes<JetKinematics>(jetKinematicsLabel_);
   LogDebug("") << "HLTMonoJetFilter: Input/maxPtSecondJet/maxDeltaPhi/triggerType : "
 	       << inputJetTag_.encode() << " "
 	       << maxPtSecondJet_ << " " 
@@ -51,9 +55,67 @@ HLTMonoJetFilter<T>::fillDescriptions(edm::ConfigurationDescriptions& descriptio
   desc.add<double>("maxPtSecondJet",9999.);
   desc.add<double>("maxDeltaPhi",99.);
   desc.add<int>("triggerType",trigger::TriggerJet);
+  desc.add<edm::InputTag>("jetKinematicsLabel",edm::InputTag(""));
   descriptions.add(std::string("hlt")+std::string(typeid(HLTMonoJetFilter<T>).name()),desc);
 }
 
+//
+// ------------ add the two leading jets if they pass the cuts  ------------
+//
+template<typename T>
+template<class C, class P>
+int
+HLTMonoJetFilter<T>::addMonoJet(C const & jets, unsigned int nJets, P position, edm::Handle<std::vector<T>> const & objects, trigger::TriggerFilterObjectWithRefs & filterproduct) const
+{
+  typedef edm::Ref<std::vector<T>> TRef;
+
+  // Ref to Candidate object to be recorded in filter object
+  TRef ref1, ref2;
+
+  int n(0);
+
+  int countJet(0);
+  double jet1Phi = 0.;
+  double jet2Phi = 0.;
+  double jet2Pt  = 0.;
+
+  for (unsigned int i = 0; i < nJets; ++i) {
+    if(countJet==0){
+      ref1=TRef(objects,position(i));
+      jet1Phi  = jets[i].phi();
+    }
+    if(countJet==1){
+      ref2=TRef(objects,position(i));
+      jet2Pt   = jets[i].pt();
+      jet2Phi  = jets[i].phi();
+    }
+    countJet++;
+    if(countJet>=2) break;
+  }
+
+  if(countJet==1){
+    n=1;
+  }
+  else if(countJet>1 && jet2Pt<maxPtSecondJet_){
+    n=1;
+  }
+  else if(countJet>1 && jet2Pt>=maxPtSecondJet_){
+    double Dphi=std::abs(reco::deltaPhi(jet1Phi,jet2Phi));
+    if(Dphi>=maxDeltaPhi_) n=-1;
+    else n=1;
+  }
+  else{
+    n=-1;
+  }
+
+  if(n==1){
+    filterproduct.addObject(triggerType_,ref1);
+    if(countJet>1) filterproduct.addObject(triggerType_,ref2);
+  }
+
+  return n;
+}
+
 //
 // ------------ method called to produce the data  ------------
 //
@@ -67,14 +129,10 @@ HLTMonoJetFilter<T>::hltFilter(edm::Event& iEvent, const edm::EventSetup& iSetup
   using namespace trigger;
 
   typedef vector<T> TCollection;
-  typedef Ref<TCollection> TRef;
   
   // The filter object
   if (saveTags()) filterproduct.addCollectionTag(inputJetTag_);
 
-  // Ref to Candidate object to be recorded in filter object
-  TRef ref1, ref2;
-
   // get hold of collection of objects
   Handle<TCollection> objects;
   iEvent.getByToken (m_theObjectToken,objects);
@@ -83,45 +141,18 @@ HLTMonoJetFilter<T>::hltFilter(edm::Event& iEvent, const edm::EventSetup& iSetup
   int n(0);
 
   if(objects->size() > 0){ 
-    int countJet(0);
-    double jet1Phi = 0.;
-    double jet2Phi = 0.;
-    double jet2Pt  = 0.;
-
-    typename TCollection::const_iterator i ( objects->begin() );
-    for (; i!=objects->end(); i++) {
-      if(countJet==0){
-	ref1=TRef(objects,distance(objects->begin(),i));
-	jet1Phi  = i->phi();
-      }
-      if(countJet==1){
-	ref2=TRef(objects,distance(objects->begin(),i));
-	jet2Pt   = i->pt();
-	jet2Phi  = i->phi();
-      }
-      countJet++;
-      if(countJet>=2) break;
-    }
-  
-    if(countJet==1){
-      n=1;
-    }
-    else if(countJet>1 && jet2Pt<maxPtSecondJet_){
-      n=1;
-    }
-    else if(countJet>1 && jet2Pt>=maxPtSecondJet_){
-      double Dphi=std::abs(deltaPhi(jet1Phi,jet2Phi));
-      if(Dphi>=maxDeltaPhi_) n=-1;
-      else n=1;
-    }
-    else{
-      n=-1;
-    }
-  
-    if(n==1){
-      filterproduct.addObject(triggerType_,ref1);
-      if(countJet>1) filterproduct.addObject(triggerType_,ref2);
+    if (useJetKinematics_) {
+      Handle<JetKinematics> jetKinematics;
+      iEvent.getByToken (m_theJetKinematicsToken,jetKinematics);
+      const JetKinematics & kin = *jetKinematics;
+      // the two leading jets are used whatever their pt
+      if (kin.preselected())
+        throw cms::Exception("Configuration") << "HLTMonoJetFilter: JetKinematics " << jetKinematicsLabel_
+                                              << " only has the jets with pt > " << kin.minPt() << ".\n";
+      n = addMonoJet(kin, kin.size(), [&kin](unsigned int i) { return kin.index()[i]; }, objects, filterproduct);
     }
+    else
+      n = addMonoJet(*objects, objects->size(), [](unsigned int i) { return i; }, objects, filterproduct);
   }
 
   bool accept(n==1); 
@@ -0,0 +1,179 @@
+/** \class HLTMultiHtMhtProducer
+ *
+ * See header file for documentation
+ *
+ */
+
+#include "HLTrigger/JetMET/interface/HLTMultiHtMhtProducer.h"
+
+#include <cmath>
+
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "DataFormats/Common/interface/Handle.h"
+
+
+// Working point from its PSet
+HLTMultiHtMhtProducer::WorkingPoint::WorkingPoint(const edm::ParameterSet & pset) :
+  label                   ( pset.getParameter<std::string>("label") ),
+  usePt                   ( pset.getParameter<bool>("usePt") ),
+  excludePFMuons          ( pset.getParameter<bool>("excludePFMuons") ),
+  minNJetHt               ( pset.getParameter<int>("minNJetHt") ),
+  minNJetMht              ( pset.getParameter<int>("minNJetMht") ),
+  minPtJetHt              ( pset.getParameter<double>("minPtJetHt") ),
+  minPtJetMht             ( pset.getParameter<double>("minPtJetMht") ),
+  maxEtaJetHt             ( pset.getParameter<double>("maxEtaJetHt") ),
+  maxEtaJetMht            ( pset.getParameter<double>("maxEtaJetMht") ) {
+}
+
+// Constructor
+HLTMultiHtMhtProducer::HLTMultiHtMhtProducer(const edm::ParameterSet & iConfig) :
+  needPt_                 ( false ),
+  needEt_                 ( false ),
+  needPFMuons_            ( false ),
+  jetsLabel_              ( iConfig.getParameter<edm::InputTag>("jetsLabel") ),
+  pfCandidatesLabel_      ( iConfig.getParameter<edm::InputTag>("pfCandidatesLabel") ) {
+    std::vector<edm::ParameterSet> psets = iConfig.getParameter<std::vector<edm::ParameterSet> >("workingPoints");
+    for (unsigned int i = 0; i < psets.size(); ++i) {
+        workingPoints_.push_back(WorkingPoint(psets[i]));
+        WorkingPoint & wp = workingPoints_.back();
+        // as in HLTHtMhtProducer, no muon is excluded without PFCandidates
+        if (pfCandidatesLabel_.label() == "")
+            wp.excludePFMuons = false;
+        needPt_      = needPt_ || wp.usePt;
+        needEt_      = needEt_ || !wp.usePt;
+        needPFMuons_ = needPFMuons_ || wp.excludePFMuons;
+    }
+
+    m_theJetToken = consumes<edm::View<reco::Jet>>(jetsLabel_);
+    if (needPFMuons_)
+        m_thePFCandidateToken = consumes<reco::PFCandidateCollection>(pfCandidatesLabel_);
+
+    // Register the products, one per working point
+    for (unsigned int i = 0; i < workingPoints_.size(); ++i)
+        produces<reco::METCollection>(workingPoints_[i].label);
+}
+
+// Destructor
+HLTMultiHtMhtProducer::~HLTMultiHtMhtProducer() {}
+
+// Fill descriptions
+void HLTMultiHtMhtProducer::fillDescriptions(edm::ConfigurationDescriptions & descriptions) {
+    // Working point defaults are those of hltHtMht
+    edm::ParameterSetDescription wpDesc;
+    wpDesc.add<std::string>("label", "");
+    wpDesc.add<bool>("usePt", false);
+    wpDesc.add<bool>("excludePFMuons", false);
+    wpDesc.add<int>("minNJetHt", 0);
+    wpDesc.add<int>("minNJetMht", 0);
+    wpDesc.add<double>("minPtJetHt", 40.);
+    wpDesc.add<double>("minPtJetMht", 30.);
+    wpDesc.add<double>("maxEtaJetHt", 3.);
+    wpDesc.add<double>("maxEtaJetMht", 5.);
+
+    edm::ParameterSet wp;
+    wp.addParameter<std::string>("label", "");
+    wp.addParameter<bool>("usePt", false);
+    wp.addParameter<bool>("excludePFMuons", false);
+    wp.addParameter<int>("minNJetHt", 0);
+    wp.addParameter<int>("minNJetMht", 0);
+    wp.addParameter<double>("minPtJetHt", 40.);
+    wp.addParameter<double>("minPtJetMht", 30.);
+    wp.addParameter<double>("maxEtaJetHt", 3.);
+    wp.addParameter<double>("maxEtaJetMht", 5.);
+    std::vector<edm::ParameterSet> wps(1, wp);
+
+    edm::ParameterSetDescription desc;
+    desc.addVPSet("workingPoints", wpDesc, wps);
+    desc.add<edm::InputTag>("jetsLabel", edm::InputTag("hltCaloJetL1FastJetCorrected"));
+    desc.add<edm::InputTag>("pfCandidatesLabel",  edm::InputTag("hltParticleFlow"));
+    descriptions.add("hltMultiHtMhtProducer", desc);
+}
+
+// Produce the products
+void HLTMultiHtMhtProducer::produce(edm::Event& iEvent, const edm::EventSetup& iSetup) {
+
+    edm::Handle<reco::JetView> jets;
+    iEvent.getByToken(m_theJetToken, jets);
+
+    // Read the jets once, computing each quantity as HLTHtMhtProducer does
+    const unsigned int nJets = jets->size();
+    jetAbsEta_.resize(nJets);
+    jetPt_.resize(needPt_ ? nJets : 0);
+    jetPx_.resize(needPt_ ? nJets : 0);
+    jetPy_.resize(needPt_ ? nJets : 0);
+    jetEt_.resize(needEt_ ? nJets : 0);
+    jetEx_.resize(needEt_ ? nJets : 0);
+    jetEy_.resize(needEt_ ? nJets : 0);
+    for (unsigned int i = 0; i < nJets; ++i) {
+        const reco::Jet & jet = (*jets)[i];
+        jetAbsEta_[i] = std::abs(jet.eta());
+        if (needPt_) {
+            jetPt_[i] = jet.pt();
+            jetPx_[i] = jet.px();
+            jetPy_[i] = jet.py();
+        }
+        if (needEt_) {
+            double phi = jet.phi();
+            jetEt_[i] = jet.et();
+            jetEx_[i] = jetEt_[i] * cos(phi);
+            jetEy_[i] = jetEt_[i] * sin(phi);
+        }
+    }
+
+    muonPx_.clear();
+    muonPy_.clear();
+    if (needPFMuons_) {
+        edm::Handle<reco::PFCandidateCollection> pfCandidates;
+        iEvent.getByToken(m_thePFCandidateToken, pfCandidates);
+        for (reco::PFCandidateCollection::const_iterator j = pfCandidates->begin(); j != pfCandidates->end(); ++j) {
+            if (std::abs(j->pdgId()) == 13) {
+                muonPx_.push_back(j->px());
+                muonPy_.push_back(j->py());
+            }
+        }
+    }
+
+    for (unsigned int iwp = 0; iwp < workingPoints_.size(); ++iwp) {
+        const WorkingPoint & wp = workingPoints_[iwp];
+        const double * pt = wp.usePt ? jetPt_.data() : jetEt_.data();
+        const double * px = wp.usePt ? jetPx_.data() : jetEx_.data();
+        const double * py = wp.usePt ? jetPy_.data() : jetEy_.data();
+
+        int nj_ht = 0, nj_mht = 0;
+        double ht = 0., mhx = 0., mhy = 0.;
+
+        for (unsigned int i = 0; i < nJets; ++i) {
+            if (pt[i] > wp.minPtJetHt && jetAbsEta_[i] < wp.maxEtaJetHt) {
+                ht += pt[i];
+                ++nj_ht;
+            }
+
+            if (pt[i] > wp.minPtJetMht && jetAbsEta_[i] < wp.maxEtaJetMht) {
+                mhx -= px[i];
+                mhy -= py[i];
+                ++nj_mht;
+            }
+        }
+
+        if (wp.excludePFMuons) {
+            for (unsigned int i = 0; i < muonPx_.size(); ++i) {
+                mhx += muonPx_[i];
+                mhy += muonPy_[i];
+            }
+        }
+
+        if (nj_ht  < wp.minNJetHt ) { ht = 0; }
+        if (nj_mht < wp.minNJetMht) { mhx = 0; mhy = 0; }
+
+        std::auto_ptr<reco::METCollection> result(new reco::METCollection());
+        reco::MET::LorentzVector p4(mhx, mhy, 0, sqrt(mhx*mhx + mhy*mhy));
+        reco::MET::Point vtx(0, 0, 0);
+        reco::MET htmht(ht, p4, vtx);
+        result->push_back(htmht);
+
+        // Put the products into the Event
+        iEvent.put(result, wp.label);
+    }
+}
@@ -0,0 +1,48 @@
+/** \class HLTPFLightCandidateProducer
+ *
+ * See header file for documentation
+ *
+ */
+
+#include "HLTrigger/JetMET/interface/HLTPFLightCandidateProducer.h"
+#include "HLTrigger/JetMET/interface/PFLightCandidates.h"
+
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "DataFormats/Common/interface/Handle.h"
+
+
+// Constructor
+HLTPFLightCandidateProducer::HLTPFLightCandidateProducer(const edm::ParameterSet & iConfig) :
+  pfCandidatesLabel_      ( iConfig.getParameter<edm::InputTag>("pfCandidatesLabel") ) {
+    m_thePFCandidateToken = consumes<reco::PFCandidateCollection>(pfCandidatesLabel_);
+
+    // Register the products
+    produces<PFLightCandidates>();
+}
+
+// Destructor
+HLTPFLightCandidateProducer::~HLTPFLightCandidateProducer() {}
+
+// Fill descriptions
+void HLTPFLightCandidateProducer::fillDescriptions(edm::ConfigurationDescriptions & descriptions) {
+    edm::ParameterSetDescription desc;
+    desc.add<edm::InputTag>("pfCandidatesLabel",  edm::InputTag("hltParticleFlow"));
+    descriptions.add("hltPFLightCandidateProducer", desc);
+}
+
+// Produce the products
+void HLTPFLightCandidateProducer::produce(edm::Event& iEvent, const edm::EventSetup& iSetup) {
+
+    edm::Handle<reco::PFCandidateCollection> pfCandidates;
+    iEvent.getByToken(m_thePFCandidateToken, pfCandidates);
+
+    std::auto_ptr<PFLightCandidates> result(new PFLightCandidates());
+    result->reserve(pfCandidates->size());
+    for (reco::PFCandidateCollection::const_iterator j = pfCandidates->begin(); j != pfCandidates->end(); ++j)
+        result->push_back(*j);
+
+    // Put the products into the Event
+    iEvent.put(result);
+}
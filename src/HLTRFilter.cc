@@ -19,6 +19,7 @@
 #include "FWCore/Utilities/interface/InputTag.h"
 
 #include "HLTrigger/JetMET/interface/HLTRFilter.h"
+#include "HLTrigger/JetMET/interface/RazorKinematics.h"
 
 //
 // constructors and destructor
@@ -114,54 +115,31 @@ HLTRFilter::filter(edm::Event& iEvent, const edm::EventSetup& iSetup)
      return false; //invalid hemisphere collection
    }
 
-   //muons as MET
-   TLorentzVector ja(hemispheres->at(0).x(),hemispheres->at(0).y(),hemispheres->at(0).z(),hemispheres->at(0).t());
-   TLorentzVector jb(hemispheres->at(1).x(),hemispheres->at(1).y(),hemispheres->at(1).z(),hemispheres->at(1).t());
+   // MET in the transverse plane
+   const double metx = inputMet->front().px();
+   const double mety = inputMet->front().py();
 
-   std::vector<math::XYZTLorentzVector> muonVec;
-   
-   double MR = CalcMR(ja,jb);
-   double R  = CalcR(MR,ja,jb,inputMet,muonVec);
+   // megajets and muons treated as jets for each hypothesis, in the order they are stored:
+   // muons as MET, lead muon as jet, second muon as jet, both muons as jets
+   static const int nHyp[3]         = { 1, 2, 4 };
+   static const int hemiIndex[4]    = { 0, 3, 6, 8 };
+   static const int muonIndex[4][2] = { {-1, -1}, {2, -1}, {5, -1}, {5, 2} };
 
-   if(MR>=min_MR_ && R>=min_R_
-      && ( (R*R - R_offset_)*(MR-MR_offset_) )>=R_MR_cut_) return true;
+   for(int h=0; h<nHyp[nMuons]; h++){
+     razor::FourVector ja(hemispheres->at(hemiIndex[h]));
+     razor::FourVector jb(hemispheres->at(hemiIndex[h]+1));
 
-   if(nMuons==0) return false;  // if no muons and we get here, reject event
+     double mx = metx, my = mety;
+     for(int m=0; m<2 && muonIndex[h][m]>=0; m++){
+       mx -= hemispheres->at(muonIndex[h][m]).px();
+       my -= hemispheres->at(muonIndex[h][m]).py();
+     }
 
-   //Lead Muon as Jet
-   ja.SetXYZT(hemispheres->at(3).x(),hemispheres->at(3).y(),hemispheres->at(3).z(),hemispheres->at(3).t());
-   jb.SetXYZT(hemispheres->at(4).x(),hemispheres->at(4).y(),hemispheres->at(4).z(),hemispheres->at(4).t());
-   muonVec.push_back(hemispheres->at(2)); // lead muon at position 2
+     double MR = razor::calcMR(ja,jb);
+     double R  = razor::calcR(MR,ja,jb,mx,my);
 
-   MR = CalcMR(ja,jb);
-   R  = CalcR(MR,ja,jb,inputMet,muonVec);
-
-   if(MR>=min_MR_ && R>=min_R_
-      && ( (R*R - R_offset_)*(MR-MR_offset_) )>=R_MR_cut_) return true;
-   
-   if(nMuons==1) return false;  // if no muons and we get here, reject event
-
-   muonVec.pop_back();
-   //Second Muon as Jet
-   ja.SetXYZT(hemispheres->at(6).x(),hemispheres->at(6).y(),hemispheres->at(6).z(),hemispheres->at(6).t());
-   jb.SetXYZT(hemispheres->at(7).x(),hemispheres->at(7).y(),hemispheres->at(7).z(),hemispheres->at(7).t());
-   muonVec.push_back(hemispheres->at(5)); // sublead muon at position 5
-
-   MR = CalcMR(ja,jb);
-   R  = CalcR(MR,ja,jb,inputMet,muonVec);
-
-   if(MR>=min_MR_ && R>=min_R_
-      && ( (R*R - R_offset_)*(MR-MR_offset_) )>=R_MR_cut_) return true;
-
-   ja.SetXYZT(hemispheres->at(8).x(),hemispheres->at(8).y(),hemispheres->at(8).z(),hemispheres->at(8).t());
-   jb.SetXYZT(hemispheres->at(9).x(),hemispheres->at(9).y(),hemispheres->at(9).z(),hemispheres->at(9).t());
-   muonVec.push_back(hemispheres->at(2)); // lead muon at position 2
-   
-   MR = CalcMR(ja,jb);
-   R  = CalcR(MR,ja,jb,inputMet,muonVec);
-
-   if(MR>=min_MR_ && R>=min_R_
-      && ( (R*R - R_offset_)*(MR-MR_offset_) )>=R_MR_cut_) return true;   
+     if(razor::passes(MR,R,min_MR_,min_R_,R_offset_,MR_offset_,R_MR_cut_)) return true;
+   }
 
    // filter decision
    return false;
@@ -16,11 +16,13 @@
 #include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
 #include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
 #include "FWCore/Utilities/interface/InputTag.h"
+#include "FWCore/Utilities/interface/Exception.h"
 
 #include "DataFormats/RecoCandidate/interface/RecoChargedCandidate.h"
 
 #include "HLTrigger/JetMET/interface/HLTRHemisphere.h"
 
+#include<algorithm>
 #include<vector>
 
 //
@@ -29,24 +31,30 @@
 HLTRHemisphere::HLTRHemisphere(const edm::ParameterSet& iConfig) :
   inputTag_    (iConfig.getParameter<edm::InputTag>("inputTag")),
   muonTag_    (iConfig.getParameter<edm::InputTag>("muonTag")),
+  jetKinematicsLabel_(iConfig.getParameter<edm::InputTag>("jetKinematicsLabel")),
+  useJetKinematics_(jetKinematicsLabel_.label() != ""),
   doMuonCorrection_(iConfig.getParameter<bool>         ("doMuonCorrection" )),
   muonEta_     (iConfig.getParameter<double>       ("maxMuonEta" )),
   min_Jet_Pt_  (iConfig.getParameter<double>       ("minJetPt" )),
   max_Eta_     (iConfig.getParameter<double>       ("maxEta" )),
   max_NJ_      (iConfig.getParameter<int>          ("maxNJ" )),
-  accNJJets_   (iConfig.getParameter<bool>         ("acceptNJ" ))
+  accNJJets_   (iConfig.getParameter<bool>         ("acceptNJ" )),
+  approxNJJets_(iConfig.getParameter<bool>         ("approximateNJ" ))
 {
-   LogDebug("") << "Input/minJetPt/maxEta/maxNJ/acceptNJ : "
+   LogDebug("") << "Input/minJetPt/maxEta/maxNJ/acceptNJ/approximateNJ : "
 		<< inputTag_.encode() << " "
 		<< min_Jet_Pt_ << "/"
 		<< max_Eta_ << "/"
 		<< max_NJ_ << "/"
-		<< accNJJets_ << ".";
+		<< accNJJets_ << "/"
+		<< approxNJJets_ << ".";
 
-   m_theJetToken = consumes<edm::View<reco::Jet>>(inputTag_);
+   if (useJetKinematics_) m_theJetKinematicsToken = consumes<JetKinematics>(jetKinematicsLabel_);
+   else m_theJetToken = consumes<edm::View<reco::Jet>>(inputTag_);
    m_theMuonToken = consumes<std::vector<reco::RecoChargedCandidate>>(muonTag_);
    //register your products
    produces<std::vector<math::XYZTLorentzVector> >();
+   produces<RazorHemispheres>();
 }
 
 HLTRHemisphere::~HLTRHemisphere()
@@ -58,12 +66,14 @@ HLTRHemisphere::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
   edm::ParameterSetDescription desc;
   desc.add<edm::InputTag>("inputTag",edm::InputTag("hltMCJetCorJetIcone5HF07"));
   desc.add<edm::InputTag>("muonTag",edm::InputTag(""));
+  desc.add<edm::InputTag>("jetKinematicsLabel",edm::InputTag(""));
   desc.add<bool>("doMuonCorrection",false);
   desc.add<double>("maxMuonEta",2.1);
   desc.add<double>("minJetPt",30.0);
   desc.add<double>("maxEta",3.0);
   desc.add<int>("maxNJ",7);
   desc.add<bool>("acceptNJ",true);
+  desc.add<bool>("approximateNJ",false);
   descriptions.add("hltRHemisphere",desc);
 }
 
@@ -86,33 +96,60 @@ HLTRHemisphere::filter(edm::Event& iEvent, const edm::EventSetup& iSetup)
    // get hold of collection of objects
    //   Handle<CaloJetCollection> jets;
    Handle<View<Jet> > jets;
-   iEvent.getByToken (m_theJetToken,jets);
+   Handle<JetKinematics> jetKinematics;
+   if (useJetKinematics_) {
+     iEvent.getByToken (m_theJetKinematicsToken,jetKinematics);
+     // the jets not stored must fail the pt requirement
+     if (jetKinematics->preselected() && jetKinematics->minPt() >= min_Jet_Pt_)
+       throw cms::Exception("Configuration") << "HLTRHemisphere: JetKinematics " << jetKinematicsLabel_
+                                             << " only has the jets with pt > " << jetKinematics->minPt() << ".\n";
+   }
+   else
+     iEvent.getByToken (m_theJetToken,jets);
 
    // get hold of the muons, if necessary
    Handle<vector<reco::RecoChargedCandidate> > muons;
    if(doMuonCorrection_) iEvent.getByToken( m_theMuonToken,muons );
 
-   // The output Collection
+   // The output Collection, and the same hemispheres with explicit hypotheses
    std::auto_ptr<vector<math::XYZTLorentzVector> > Hemispheres(new vector<math::XYZTLorentzVector> );
+   std::auto_ptr<RazorHemispheres> razorHemispheres(new RazorHemispheres);
 
    // look at all objects, check cuts and add to filter object
    int n(0);
    vector<math::XYZTLorentzVector> JETS;
-   for (unsigned int i=0; i<jets->size(); i++) {
-     if(std::abs(jets->at(i).eta()) < max_Eta_ && jets->at(i).pt() >= min_Jet_Pt_){
-       JETS.push_back(jets->at(i).p4());
-       n++;
+   if (useJetKinematics_) {
+     const JetKinematics & kin = *jetKinematics;
+     for (unsigned int i=0; i<kin.size(); i++) {
+       if(std::abs(kin.eta()[i]) < max_Eta_ && kin.pt()[i] >= min_Jet_Pt_){
+	 JETS.push_back(LorentzVector(kin.px()[i], kin.py()[i], kin.pz()[i], kin.energy()[i]));
+	 n++;
+       }
+     }
+   }
+   else {
+     for (unsigned int i=0; i<jets->size(); i++) {
+       if(std::abs(jets->at(i).eta()) < max_Eta_ && jets->at(i).pt() >= min_Jet_Pt_){
+	 JETS.push_back(jets->at(i).p4());
+	 n++;
+       }
      }
    }
 
+  int algorithm = RazorHemispheres::kExact;
   if(n>max_NJ_ && max_NJ_!=-1){
-    iEvent.put(Hemispheres);
-    return accNJJets_; // too many jets, accept for timing
+    if(!approxNJJets_){
+      iEvent.put(Hemispheres);
+      iEvent.put(razorHemispheres);
+      return accNJJets_; // too many jets, accept for timing
+    }
+    algorithm = RazorHemispheres::kApproximate; // too many jets, use the bounded-time algorithm
   }
 
+  std::vector<std::vector<math::XYZTLorentzVector> > muonJets(1); // muons as MET
+  const int nMu = 2;
+  int muonIndex[nMu] = { -1, -1 };
   if(doMuonCorrection_){
-    const int nMu = 2;
-    int muonIndex[nMu] = { -1, -1 };
     std::vector<reco::RecoChargedCandidate>::const_iterator muonIt;
     int index   = 0;
     int nPassMu = 0;
@@ -120,88 +157,211 @@ HLTRHemisphere::filter(edm::Event& iEvent, const edm::EventSetup& iSetup)
       if(std::abs(muonIt->eta()) > muonEta_ || muonIt->pt() < min_Jet_Pt_) continue; // skip muons out of eta range or too low pT
       if(nPassMu >= 2){ // if we have already accepted two muons, accept the event
 	iEvent.put(Hemispheres); // too many muons, accept for timing      
+	iEvent.put(razorHemispheres);
 	return true;
       }
       muonIndex[nPassMu++] = index;    
     }
-    //muons as MET
-    this->ComputeHemispheres(Hemispheres,JETS);
-    //lead muon as jet
+    // all the muon hypotheses are computed together, sharing the combinations of the jets
     if(nPassMu>0){
-      std::vector<math::XYZTLorentzVector> muonJets;
-      reco::RecoChargedCandidate leadMu = muons->at(muonIndex[0]);
-      muonJets.push_back(leadMu.p4());
-      Hemispheres->push_back(leadMu.p4());
-      this->ComputeHemispheres(Hemispheres,JETS,&muonJets); // lead muon as jet
+      muonJets.push_back(std::vector<math::XYZTLorentzVector>(1, muons->at(muonIndex[0]).p4())); // lead muon as jet
       if(nPassMu>1){ // two passing muons
-	muonJets.pop_back();
-	reco::RecoChargedCandidate secondMu = muons->at(muonIndex[1]);
-	muonJets.push_back(secondMu.p4());
-	Hemispheres->push_back(secondMu.p4());
-	this->ComputeHemispheres(Hemispheres,JETS,&muonJets); // lead muon as v, second muon as jet
-	muonJets.push_back(leadMu.p4());
-	this->ComputeHemispheres(Hemispheres,JETS,&muonJets); // both muon as jets
+	muonJets.push_back(std::vector<math::XYZTLorentzVector>(1, muons->at(muonIndex[1]).p4())); // lead muon as v, second muon as jet
+	muonJets.push_back(muonJets.back());
+	muonJets.back().push_back(muons->at(muonIndex[0]).p4()); // both muon as jets
       }
     }
   }else{ // do MuonCorrection==false
-    if(n<2) return false; // not enough jets and not adding in muons
-    this->ComputeHemispheres(Hemispheres,JETS); // don't do the muon isolation, just run once and done
+    if(n<2){ // not enough jets and not adding in muons
+      razorHemispheres->setAlgorithm(RazorHemispheres::kExact);
+      iEvent.put(Hemispheres);
+      iEvent.put(razorHemispheres);
+      return false;
+    }
+    // don't do the muon isolation, just run once and done
+  }
+
+  std::vector<HemispherePair> hemispheres;
+  if(algorithm == RazorHemispheres::kApproximate)
+    ComputeHemispheresApprox(hemispheres,JETS,muonJets);
+  else
+    ComputeHemispheres(hemispheres,JETS,muonJets);
+  razorHemispheres->setAlgorithm(algorithm);
+  for(unsigned int i=0; i<hemispheres.size(); i++){
+    if(i==1) Hemispheres->push_back(muons->at(muonIndex[0]).p4());
+    if(i==2) Hemispheres->push_back(muons->at(muonIndex[1]).p4());
+    if(i==1 || i==2) razorHemispheres->addMuon(Hemispheres->back());
+    Hemispheres->push_back(hemispheres[i].first);
+    Hemispheres->push_back(hemispheres[i].second);
+    razorHemispheres->addHemispheres(hemispheres[i].first, hemispheres[i].second);
   }
   //Format: 
   // 0 muon: 2 hemispheres (2)
   // 1 muon: 2 hemisheress + leadMuP4 + 2 hemispheres (5)
   // 2 muon: 2 hemispheres + leadMuP4 + 2 hemispheres + 2ndMuP4 + 4 Hemispheres (10)
   iEvent.put(Hemispheres);
+  iEvent.put(razorHemispheres);
   return true;
 }
 
 void
-HLTRHemisphere::ComputeHemispheres(std::auto_ptr<std::vector<math::XYZTLorentzVector> >& hlist, const std::vector<math::XYZTLorentzVector>& JETS,
-				   std::vector<math::XYZTLorentzVector>* extraJets){
+HLTRHemisphere::ComputeHemispheres(std::vector<HemispherePair>& hemispheres, const std::vector<math::XYZTLorentzVector>& JETS,
+				   const std::vector<std::vector<math::XYZTLorentzVector> >& extraJets){
   using namespace math;
-  using namespace reco;
-  XYZTLorentzVector j1R(0.1, 0., 0., 0.1);
-  XYZTLorentzVector j2R(0.1, 0., 0., 0.1);
-  int nJets = JETS.size();
-  if(extraJets) nJets+=extraJets->size();
-
-  if(nJets<2){ // put empty hemispheres if not enough jets
-    hlist->push_back(j1R);
-    hlist->push_back(j2R);
-    return;
+  const unsigned int nHyp = extraJets.size();
+  const int nJets = JETS.size();
+
+  // empty hemispheres, kept if there are not enough jets
+  hemispheres.assign(nHyp, HemispherePair(XYZTLorentzVector(0.1, 0., 0., 0.1), XYZTLorentzVector(0.1, 0., 0., 0.1)));
+
+  // best combination found so far for each hypothesis
+  std::vector<double> M_minR(nHyp, 9999999999.0);
+  std::vector<unsigned int> minComb(nHyp, 0);
+  std::vector<bool> found(nHyp, false);
+
+  // Walk through the combinations of jets in Gray code order, so that each step moves a single jet
+  // between the hemispheres, and extend each of them with all the assignments of the extra objects
+  // of every hypothesis. Swapping the hemispheres does not change the mass sum, so the first object
+  // is kept in the second hemisphere and only half of the combinations are visited.
+  // Combinations are labelled as before, the first object being the most significant bit (set = first hemisphere).
+  double e1 = 0., x1 = 0., y1 = 0., z1 = 0.;
+  double e2 = 0., x2 = 0., y2 = 0., z2 = 0.;
+  for (int i = 0; i < nJets; ++i) {
+    e2 += JETS[i].E(); x2 += JETS[i].Px(); y2 += JETS[i].Py(); z2 += JETS[i].Pz();
   }
-  unsigned int N_comb = pow(2,nJets); // compute the number of combinations of jets possible
-  //Make the hemispheres
-  double M_minR = 9999999999.0;
-  unsigned int j_count;
-  for (unsigned int i = 0; i < N_comb; i++) {       
-    XYZTLorentzVector j_temp1, j_temp2;
-    unsigned int itemp = i;
-    j_count = N_comb/2;
-    unsigned int count = 0;
-    while (j_count > 0) {
-      if (itemp/j_count == 1){
-	if(count<JETS.size()) j_temp1 += JETS.at(count);
-	else j_temp1 +=extraJets->at(count-JETS.size());
-      } else {
-	if(count<JETS.size()) j_temp2 += JETS.at(count);
-	else j_temp2 +=extraJets->at(count-JETS.size());
+
+  // the running sums are only used to preselect the candidates: the best ones are summed again from
+  // scratch, in the original order, so that the megajets do not depend on the order of the walk
+  std::vector<double> tolerance(nHyp);
+  for (unsigned int h = 0; h < nHyp; ++h) {
+    double e = e2;
+    for (unsigned int k = 0; k < extraJets[h].size(); ++k) e += extraJets[h][k].E();
+    tolerance[h] = 1e-9 * e * e;
+  }
+
+  unsigned int N_comb = (nJets > 0) ? 1U << (nJets - 1) : 1; // number of distinct combinations of the jets
+  unsigned int comb = 0;
+  for (unsigned int i = 0; ; ) {
+    for (unsigned int h = 0; h < nHyp; ++h) {
+      const std::vector<XYZTLorentzVector>& extra = extraJets[h];
+      const int nExtra = extra.size();
+      const int nObj = nJets + nExtra;
+      if (nObj < 2) continue;
+      // without jets, the first extra object is the one kept in the second hemisphere
+      const unsigned int N_extra = (nJets > 0) ? 1U << nExtra : 1U << (nExtra - 1);
+      for (unsigned int a = 0; a < N_extra; ++a) {
+	double f1 = e1, u1 = x1, v1 = y1, w1 = z1;
+	double f2 = e2, u2 = x2, v2 = y2, w2 = z2;
+	for (int k = 0; k < nExtra; ++k) {
+	  if (a & (1U << (nExtra - 1 - k))) { f1 += extra[k].E(); u1 += extra[k].Px(); v1 += extra[k].Py(); w1 += extra[k].Pz(); }
+	  else                              { f2 += extra[k].E(); u2 += extra[k].Px(); v2 += extra[k].Py(); w2 += extra[k].Pz(); }
+	}
+	double M_temp = (f1*f1 - (u1*u1 + v1*v1 + w1*w1)) + (f2*f2 - (u2*u2 + v2*v2 + w2*w2));
+	if (M_temp < M_minR[h] + tolerance[h]) {
+	  const unsigned int fullComb = (comb << nExtra) | a;
+	  XYZTLorentzVector j_temp1, j_temp2;
+	  for (int j = 0; j < nObj; ++j) {
+	    const XYZTLorentzVector& p4 = (j < nJets) ? JETS[j] : extra[j - nJets];
+	    if (fullComb & (1U << (nObj - 1 - j))) j_temp1 += p4;
+	    else                                   j_temp2 += p4;
+	  }
+	  M_temp = j_temp1.M2() + j_temp2.M2();
+	  if (M_temp < M_minR[h] || (found[h] && M_temp == M_minR[h] && fullComb < minComb[h])) {
+	    M_minR[h] = M_temp;
+	    minComb[h] = fullComb;
+	    found[h] = true;
+	    hemispheres[h].first  = j_temp1;
+	    hemispheres[h].second = j_temp2;
+	  }
+	}
       }
-      itemp -= j_count * (itemp/j_count);
-      j_count /= 2;
-      count++;
     }
-    double M_temp = j_temp1.M2() + j_temp2.M2();
-    if (M_temp < M_minR) {
-      M_minR = M_temp;
-      j1R = j_temp1; 
-      j2R = j_temp2; 
+    if (++i >= N_comb) break;
+    // the next Gray code differs by the lowest set bit of i
+    int bit = 0;
+    while (!(i & (1U << bit))) ++bit;
+    const XYZTLorentzVector& jet = JETS[nJets - 1 - bit];
+    comb ^= 1U << bit;
+    if (comb & (1U << bit)) { // moved to the first hemisphere
+      e1 += jet.E(); x1 += jet.Px(); y1 += jet.Py(); z1 += jet.Pz();
+      e2 -= jet.E(); x2 -= jet.Px(); y2 -= jet.Py(); z2 -= jet.Pz();
+    } else {                  // moved back to the second hemisphere
+      e1 -= jet.E(); x1 -= jet.Px(); y1 -= jet.Py(); z1 -= jet.Pz();
+      e2 += jet.E(); x2 += jet.Px(); y2 += jet.Py(); z2 += jet.Pz();
     }
   }
+}
 
-  hlist->push_back(j1R);
-  hlist->push_back(j2R);
-  return;
+void
+HLTRHemisphere::ComputeHemispheresApprox(std::vector<HemispherePair>& hemispheres, const std::vector<math::XYZTLorentzVector>& JETS,
+					 const std::vector<std::vector<math::XYZTLorentzVector> >& extraJets){
+  using namespace math;
+  const unsigned int nHyp = extraJets.size();
+
+  // empty hemispheres, kept if there are not enough jets
+  hemispheres.assign(nHyp, HemispherePair(XYZTLorentzVector(0.1, 0., 0., 0.1), XYZTLorentzVector(0.1, 0., 0., 0.1)));
+
+  std::vector<const XYZTLorentzVector*> objects;
+  std::vector<std::pair<double, int> > order;
+  std::vector<bool> first;
+  for (unsigned int h = 0; h < nHyp; ++h) {
+    objects.clear();
+    for (unsigned int i = 0; i < JETS.size(); ++i) objects.push_back(&JETS[i]);
+    for (unsigned int i = 0; i < extraJets[h].size(); ++i) objects.push_back(&extraJets[h][i]);
+    const int nObj = objects.size();
+    if (nObj < 2) continue;
+
+    // seed the hemispheres with the two hardest objects, then add the others from the hardest to the
+    // softest, each to the hemisphere whose mass grows the least
+    order.clear();
+    for (int j = 0; j < nObj; ++j) order.push_back(std::make_pair(-objects[j]->Pt(), j));
+    std::sort(order.begin(), order.end());
+
+    first.assign(nObj, false);
+    double e1 = 0., x1 = 0., y1 = 0., z1 = 0.;
+    double e2 = 0., x2 = 0., y2 = 0., z2 = 0.;
+    for (int k = 0; k < nObj; ++k) {
+      const int j = order[k].second;
+      const XYZTLorentzVector& p4 = *objects[j];
+      // the increase of M^2 is 2 (E_h E - p_h . p) + m^2 in both hemispheres
+      const double dM1 = e1*p4.E() - (x1*p4.Px() + y1*p4.Py() + z1*p4.Pz());
+      const double dM2 = e2*p4.E() - (x2*p4.Px() + y2*p4.Py() + z2*p4.Pz());
+      if (k == 0 || (k > 1 && dM1 < dM2)) {
+	first[j] = true;
+	e1 += p4.E(); x1 += p4.Px(); y1 += p4.Py(); z1 += p4.Pz();
+      } else {
+	e2 += p4.E(); x2 += p4.Px(); y2 += p4.Py(); z2 += p4.Pz();
+      }
+    }
+
+    // move single objects between the hemispheres while that reduces the mass sum, with a bounded number of passes
+    for (int pass = 0; pass < nObj; ++pass) {
+      bool moved = false;
+      for (int j = 0; j < nObj; ++j) {
+	const XYZTLorentzVector& p4 = *objects[j];
+	// change of M1^2 + M2^2 when moving the object from hemisphere a to hemisphere b: 2 p.(P_b - P_a) + 2 m^2
+	const double sign = first[j] ? 1. : -1.;
+	const double dE = sign * (e2 - e1), dX = sign * (x2 - x1), dY = sign * (y2 - y1), dZ = sign * (z2 - z1);
+	const double delta = (p4.E()*dE - (p4.Px()*dX + p4.Py()*dY + p4.Pz()*dZ)) + p4.M2();
+	if (delta < 0.) {
+	  first[j] = !first[j];
+	  e1 -= sign * p4.E(); x1 -= sign * p4.Px(); y1 -= sign * p4.Py(); z1 -= sign * p4.Pz();
+	  e2 += sign * p4.E(); x2 += sign * p4.Px(); y2 += sign * p4.Py(); z2 += sign * p4.Pz();
+	  moved = true;
+	}
+      }
+      if (!moved) break;
+    }
+
+    // sum the megajets in the original order, as the exact algorithm does
+    XYZTLorentzVector j_temp1, j_temp2;
+    for (int j = 0; j < nObj; ++j) {
+      if (first[j]) j_temp1 += *objects[j];
+      else          j_temp2 += *objects[j];
+    }
+    hemispheres[h].first  = j_temp1;
+    hemispheres[h].second = j_temp2;
+  }
 }
 
 DEFINE_FWK_MODULE(HLTRHemisphere);
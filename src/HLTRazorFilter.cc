@@ -0,0 +1,173 @@
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+
+#include "DataFormats/Common/interface/Handle.h"
+
+#include "FWCore/Framework/interface/MakerMacros.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "FWCore/Utilities/interface/InputTag.h"
+
+#include "HLTrigger/JetMET/interface/HLTRazorFilter.h"
+#include "HLTrigger/JetMET/interface/HLTRHemisphere.h"
+#include "HLTrigger/JetMET/interface/RazorKinematics.h"
+
+#include<vector>
+
+//
+// constructors and destructor
+//
+HLTRazorFilter::HLTRazorFilter(const edm::ParameterSet& iConfig) :
+  inputTag_    (iConfig.getParameter<edm::InputTag>("inputTag")),
+  muonTag_     (iConfig.getParameter<edm::InputTag>("muonTag")),
+  inputMetTag_ (iConfig.getParameter<edm::InputTag>("inputMetTag")),
+  doMuonCorrection_(iConfig.getParameter<bool>     ("doMuonCorrection" )),
+  muonEta_     (iConfig.getParameter<double>       ("maxMuonEta" )),
+  min_Jet_Pt_  (iConfig.getParameter<double>       ("minJetPt" )),
+  max_Eta_     (iConfig.getParameter<double>       ("maxEta" )),
+  max_NJ_      (iConfig.getParameter<int>          ("maxNJ" )),
+  accNJJets_   (iConfig.getParameter<bool>         ("acceptNJ" )),
+  approxNJJets_(iConfig.getParameter<bool>         ("approximateNJ" )),
+  min_R_       (iConfig.getParameter<double>       ("minR" )),
+  min_MR_      (iConfig.getParameter<double>       ("minMR" )),
+  R_offset_    (iConfig.getParameter<double>       ("R2Offset" )),
+  MR_offset_   (iConfig.getParameter<double>       ("MROffset" )),
+  R_MR_cut_    (iConfig.getParameter<double>       ("RMRCut" ))
+{
+   LogDebug("") << "Inputs/minJetPt/maxEta/maxNJ/acceptNJ/approximateNJ/minR/minMR/R2Offset/MROffset/RMRCut : "
+		<< inputTag_.encode() << " "
+		<< inputMetTag_.encode() << " "
+		<< min_Jet_Pt_ << "/"
+		<< max_Eta_ << "/"
+		<< max_NJ_ << "/"
+		<< accNJJets_ << "/"
+		<< approxNJJets_ << "/"
+		<< min_R_ << "/"
+		<< min_MR_ << "/"
+		<< R_offset_ << "/"
+		<< MR_offset_ << "/"
+		<< R_MR_cut_ << ".";
+
+   m_theJetToken = consumes<edm::View<reco::Jet>>(inputTag_);
+   m_theMuonToken = consumes<std::vector<reco::RecoChargedCandidate>>(muonTag_);
+   m_theMETToken = consumes<reco::CaloMETCollection>(inputMetTag_);
+}
+
+HLTRazorFilter::~HLTRazorFilter()
+{
+}
+
+void
+HLTRazorFilter::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+  edm::ParameterSetDescription desc;
+  desc.add<edm::InputTag>("inputTag",edm::InputTag("hltMCJetCorJetIcone5HF07"));
+  desc.add<edm::InputTag>("muonTag",edm::InputTag(""));
+  desc.add<edm::InputTag>("inputMetTag",edm::InputTag("hltMet"));
+  desc.add<bool>("doMuonCorrection",false);
+  desc.add<double>("maxMuonEta",2.1);
+  desc.add<double>("minJetPt",30.0);
+  desc.add<double>("maxEta",3.0);
+  desc.add<int>("maxNJ",7);
+  desc.add<bool>("acceptNJ",true);
+  desc.add<bool>("approximateNJ",false);
+  desc.add<double>("minR",0.3);
+  desc.add<double>("minMR",100.0);
+  desc.add<double>("R2Offset",0.0);
+  desc.add<double>("MROffset",0.0);
+  desc.add<double>("RMRCut",-999999.0);
+  descriptions.add("hltRazorFilter",desc);
+}
+
+//
+// member functions
+//
+
+// ------------ method called on each new Event  ------------
+bool
+HLTRazorFilter::filter(edm::Event& iEvent, const edm::EventSetup& iSetup)
+{
+   using namespace std;
+   using namespace edm;
+   using namespace reco;
+
+   Handle<View<Jet> > jets;
+   iEvent.getByToken (m_theJetToken,jets);
+
+   Handle<CaloMETCollection> inputMet;
+   iEvent.getByToken(m_theMETToken,inputMet);
+
+   Handle<vector<RecoChargedCandidate> > muons;
+   if(doMuonCorrection_) iEvent.getByToken(m_theMuonToken,muons);
+
+   if (not jets.isValid() or not inputMet.isValid())
+     return false;
+
+   // jets entering the hemispheres, selected as in HLTRHemisphere
+   int n(0);
+   vector<math::XYZTLorentzVector> JETS;
+   for (unsigned int i=0; i<jets->size(); i++) {
+     if(std::abs((*jets)[i].eta()) < max_Eta_ && (*jets)[i].pt() >= min_Jet_Pt_){
+       JETS.push_back((*jets)[i].p4());
+       n++;
+     }
+   }
+
+   bool approximate = false;
+   if(n>max_NJ_ && max_NJ_!=-1){
+     if(!approxNJJets_) return accNJJets_; // too many jets, accept for timing
+     approximate = true;
+   }
+
+   // muons treated as jets in each hypothesis: none, lead, second, both
+   vector<vector<math::XYZTLorentzVector> > muonJets(1);
+   if(doMuonCorrection_){
+     vector<math::XYZTLorentzVector> passMu;
+     for(vector<RecoChargedCandidate>::const_iterator muonIt = muons->begin(); muonIt!=muons->end(); muonIt++){
+       if(std::abs(muonIt->eta()) > muonEta_ || muonIt->pt() < min_Jet_Pt_) continue; // skip muons out of eta range or too low pT
+       if(passMu.size() >= 2) return accNJJets_; // too many muons, accept for timing
+       passMu.push_back(muonIt->p4());
+     }
+     if(passMu.size()>0){
+       muonJets.push_back(vector<math::XYZTLorentzVector>(1, passMu[0]));
+       if(passMu.size()>1){
+	 muonJets.push_back(vector<math::XYZTLorentzVector>(1, passMu[1]));
+	 muonJets.push_back(muonJets.back());
+	 muonJets.back().push_back(passMu[0]);
+       }
+     }
+   }else{
+     if(n<2) return false; // not enough jets and not adding in muons
+   }
+
+   vector<HLTRHemisphere::HemispherePair> hemispheres;
+   if(approximate)
+     HLTRHemisphere::ComputeHemispheresApprox(hemispheres,JETS,muonJets);
+   else
+     HLTRHemisphere::ComputeHemispheres(hemispheres,JETS,muonJets);
+
+   // MET in the transverse plane
+   const double metx = inputMet->front().px();
+   const double mety = inputMet->front().py();
+
+   for(unsigned int h=0; h<hemispheres.size(); h++){
+     razor::FourVector ja(hemispheres[h].first);
+     razor::FourVector jb(hemispheres[h].second);
+
+     double mx = metx, my = mety;
+     for(unsigned int m=0; m<muonJets[h].size(); m++){
+       mx -= muonJets[h][m].px();
+       my -= muonJets[h][m].py();
+     }
+
+     double MR = razor::calcMR(ja,jb);
+     double R  = razor::calcR(MR,ja,jb,mx,my);
+
+     if(razor::passes(MR,R,min_MR_,min_R_,R_offset_,MR_offset_,R_MR_cut_)) return true;
+   }
+
+   // filter decision
+   return false;
+}
+
+DEFINE_FWK_MODULE(HLTRazorFilter);
@@ -0,0 +1,81 @@
+/** \class HLTRazorVariablesFilter
+ *
+ * See header file for documentation
+ *
+ */
+
+#include "HLTrigger/JetMET/interface/HLTRazorVariablesFilter.h"
+#include "HLTrigger/JetMET/interface/RazorKinematics.h"
+
+#include "FWCore/Framework/interface/MakerMacros.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "DataFormats/Common/interface/Handle.h"
+
+
+// Constructor
+HLTRazorVariablesFilter::HLTRazorVariablesFilter(const edm::ParameterSet & iConfig) :
+  inputTag_  ( iConfig.getParameter<edm::InputTag>("inputTag") ),
+  minR_      ( iConfig.getParameter<std::vector<double> >("minR") ),
+  minMR_     ( iConfig.getParameter<std::vector<double> >("minMR") ),
+  R_offset_  ( iConfig.getParameter<std::vector<double> >("R2Offset") ),
+  MR_offset_ ( iConfig.getParameter<std::vector<double> >("MROffset") ),
+  R_MR_cut_  ( iConfig.getParameter<std::vector<double> >("RMRCut") ),
+  accept_NJ_ ( iConfig.getParameter<bool>("acceptNJ") ),
+  nOrs_      ( minR_.size() ) {  // number of settings to .OR.
+    if (!( minR_.size() == minMR_.size() &&
+           minR_.size() == R_offset_.size() &&
+           minR_.size() == MR_offset_.size() &&
+           minR_.size() == R_MR_cut_.size() ) ||
+        minR_.size() == 0 ) {
+        nOrs_ = (minMR_.size()     < nOrs_ ? minMR_.size()     : nOrs_);
+        nOrs_ = (R_offset_.size()  < nOrs_ ? R_offset_.size()  : nOrs_);
+        nOrs_ = (MR_offset_.size() < nOrs_ ? MR_offset_.size() : nOrs_);
+        nOrs_ = (R_MR_cut_.size()  < nOrs_ ? R_MR_cut_.size()  : nOrs_);
+        edm::LogError("HLTRazorVariablesFilter") << "inconsistent module configuration!";
+    }
+
+    m_theInputToken = consumes<RazorVariables>(inputTag_);
+}
+
+// Destructor
+HLTRazorVariablesFilter::~HLTRazorVariablesFilter() {}
+
+// Fill descriptions
+void HLTRazorVariablesFilter::fillDescriptions(edm::ConfigurationDescriptions & descriptions) {
+    std::vector<double> tmp(1, 0.);
+    edm::ParameterSetDescription desc;
+    desc.add<edm::InputTag>("inputTag", edm::InputTag("hltRazorVariablesProducer"));
+    tmp[0] =       0.3; desc.add<std::vector<double> >("minR",     tmp);
+    tmp[0] =     100.0; desc.add<std::vector<double> >("minMR",    tmp);
+    tmp[0] =       0.0; desc.add<std::vector<double> >("R2Offset", tmp);
+    tmp[0] =       0.0; desc.add<std::vector<double> >("MROffset", tmp);
+    tmp[0] = -999999.0; desc.add<std::vector<double> >("RMRCut",   tmp);
+    desc.add<bool>("acceptNJ", true);
+    descriptions.add("hltRazorVariablesFilter", desc);
+}
+
+// Make filter decision
+bool HLTRazorVariablesFilter::filter(edm::Event & iEvent, const edm::EventSetup & iSetup) {
+
+    edm::Handle<RazorVariables> variables;
+    iEvent.getByToken(m_theInputToken, variables);
+
+    if (!variables.isValid())
+        return false;
+
+    // the hemispheres are not computed if the number of jets or muons in the event is too large
+    if (variables->algorithm() == RazorHemispheres::kNone)
+        return accept_NJ_;
+
+    // Take the .OR. of all working points and muon hypotheses
+    for (unsigned int h = 0; h < variables->size(); ++h)
+        for (unsigned int i = 0; i < nOrs_; ++i)
+            if (razor::passes(variables->MR(h), variables->R(h), minMR_[i], minR_[i], R_offset_[i], MR_offset_[i], R_MR_cut_[i]))
+                return true;
+
+    return false;
+}
+
+DEFINE_FWK_MODULE(HLTRazorVariablesFilter);
@@ -0,0 +1,86 @@
+/** \class HLTRazorVariablesProducer
+ *
+ * See header file for documentation
+ *
+ */
+
+#include "HLTrigger/JetMET/interface/HLTRazorVariablesProducer.h"
+#include "HLTrigger/JetMET/interface/RazorKinematics.h"
+#include "HLTrigger/JetMET/interface/RazorVariables.h"
+
+#include "FWCore/Framework/interface/MakerMacros.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "DataFormats/Common/interface/Handle.h"
+
+
+// Constructor
+HLTRazorVariablesProducer::HLTRazorVariablesProducer(const edm::ParameterSet & iConfig) :
+  inputTag_    ( iConfig.getParameter<edm::InputTag>("inputTag") ),
+  inputMetTag_ ( iConfig.getParameter<edm::InputTag>("inputMetTag") ) {
+    m_theHemispheresToken = consumes<RazorHemispheres>(inputTag_);
+    m_theMETToken = consumes<reco::CaloMETCollection>(inputMetTag_);
+
+    // Register the products
+    produces<RazorVariables>();
+}
+
+// Destructor
+HLTRazorVariablesProducer::~HLTRazorVariablesProducer() {}
+
+// Fill descriptions
+void HLTRazorVariablesProducer::fillDescriptions(edm::ConfigurationDescriptions & descriptions) {
+    edm::ParameterSetDescription desc;
+    desc.add<edm::InputTag>("inputTag", edm::InputTag("hltRHemisphere"));
+    desc.add<edm::InputTag>("inputMetTag", edm::InputTag("hltMet"));
+    descriptions.add("hltRazorVariablesProducer", desc);
+}
+
+// Produce the products
+void HLTRazorVariablesProducer::produce(edm::Event & iEvent, const edm::EventSetup & iSetup) {
+
+    edm::Handle<RazorHemispheres> hemispheres;
+    iEvent.getByToken(m_theHemispheresToken, hemispheres);
+
+    edm::Handle<reco::CaloMETCollection> met;
+    iEvent.getByToken(m_theMETToken, met);
+
+    // Create a pointer to the products
+    std::auto_ptr<RazorVariables> result(new RazorVariables());
+
+    // without hemispheres or MET the product is still put, with no variables and an algorithm
+    // other than kNone, so that HLTRazorVariablesFilter rejects the event
+    if (!hemispheres.isValid() || !met.isValid() || met->size() == 0) {
+        result->setAlgorithm(RazorHemispheres::kExact);
+        iEvent.put(result);
+        return;
+    }
+
+    result->setAlgorithm(hemispheres->algorithm());
+
+    const double metx = met->front().px();
+    const double mety = met->front().py();
+
+    for (unsigned int h = 0; h < hemispheres->size(); ++h) {
+        RazorHemispheres::Hypothesis hypothesis = RazorHemispheres::Hypothesis(h);
+        razor::FourVector ja(hemispheres->first(hypothesis));
+        razor::FourVector jb(hemispheres->second(hypothesis));
+
+        // muons treated as jets are removed from the MET
+        double mx = metx, my = mety;
+        std::vector<math::XYZTLorentzVector> muons = hemispheres->muonsAsJets(hypothesis);
+        for (unsigned int m = 0; m < muons.size(); ++m) {
+            mx -= muons[m].px();
+            my -= muons[m].py();
+        }
+
+        double MR = razor::calcMR(ja, jb);
+        double R  = razor::calcR(MR, ja, jb, mx, my);
+        result->add(MR, R);
+    }
+
+    iEvent.put(result);
+}
+
+DEFINE_FWK_MODULE(HLTRazorVariablesProducer);
@@ -28,11 +28,14 @@ HLTTrackMETProducer::HLTTrackMETProducer(const edm::ParameterSet & iConfig) :
   jetsLabel_              ( iConfig.getParameter<edm::InputTag>("jetsLabel") ),
   tracksLabel_            ( iConfig.getParameter<edm::InputTag>("tracksLabel") ),
   pfRecTracksLabel_       ( iConfig.getParameter<edm::InputTag>("pfRecTracksLabel") ),
-  pfCandidatesLabel_      ( iConfig.getParameter<edm::InputTag>("pfCandidatesLabel") ) {
+  pfCandidatesLabel_      ( iConfig.getParameter<edm::InputTag>("pfCandidatesLabel") ),
+  pfLightCandidatesLabel_ ( iConfig.getParameter<edm::InputTag>("pfLightCandidatesLabel") ),
+  usePFLightCandidates_   ( pfLightCandidatesLabel_.label() != "" ) {
     m_theJetToken = consumes<edm::View<reco::Jet>>(jetsLabel_);
     m_theTrackToken = consumes<reco::TrackCollection>(tracksLabel_);
     m_theRecTrackToken = consumes<reco::PFRecTrackCollection>(pfRecTracksLabel_);
     m_thePFCandidateToken = consumes<reco::PFCandidateCollection>(pfCandidatesLabel_);
+    if (usePFLightCandidates_) m_thePFLightCandidateToken = consumes<PFLightCandidates>(pfLightCandidatesLabel_);
 
     // Register the products
     produces<reco::METCollection>();
@@ -58,6 +61,7 @@ void HLTTrackMETProducer::fillDescriptions(edm::ConfigurationDescriptions & desc
     desc.add<edm::InputTag>("tracksLabel",  edm::InputTag("hltL3Muons"));
     desc.add<edm::InputTag>("pfRecTracksLabel",  edm::InputTag("hltLightPFTracks"));
     desc.add<edm::InputTag>("pfCandidatesLabel",  edm::InputTag("hltParticleFlow"));
+    desc.add<edm::InputTag>("pfLightCandidatesLabel",  edm::InputTag(""));
     descriptions.add("hltTrackMETProducer", desc);
 }
 
@@ -67,7 +71,7 @@ void HLTTrackMETProducer::produce(edm::Event& iEvent, const edm::EventSetup& iSe
     // Create a pointer to the products
     std::auto_ptr<reco::METCollection> result(new reco::METCollection());
 
-    if (pfCandidatesLabel_.label() == "")
+    if (pfCandidatesLabel_.label() == "" && !usePFLightCandidates_)
         excludePFMuons_ = false;
 
     bool useJets = !useTracks_ && !usePFRecTracks_ && !usePFCandidatesCharged_ && !usePFCandidates_;
@@ -85,7 +89,10 @@ void HLTTrackMETProducer::produce(edm::Event& iEvent, const edm::EventSetup& iSe
     if (usePFRecTracks_) iEvent.getByToken(m_theRecTrackToken, pfRecTracks);
 
     edm::Handle<reco::PFCandidateCollection> pfCandidates;
-    if (excludePFMuons_ || usePFCandidatesCharged_ || usePFCandidates_)
+    edm::Handle<PFLightCandidates> pfLightCandidates;
+    if ((excludePFMuons_ || usePFCandidatesCharged_ || usePFCandidates_) && usePFLightCandidates_)
+        iEvent.getByToken(m_thePFLightCandidateToken, pfLightCandidates);
+    else if (excludePFMuons_ || usePFCandidatesCharged_ || usePFCandidates_)
         iEvent.getByToken(m_thePFCandidateToken, pfCandidates);
 
     int nj = 0;
@@ -137,6 +144,24 @@ void HLTTrackMETProducer::produce(edm::Event& iEvent, const edm::EventSetup& iSe
             }
         }
 
+    } else if ((usePFCandidatesCharged_ || usePFCandidates_) && usePFLightCandidates_) {
+        const unsigned int n = pfLightCandidates->size();
+        const int    * charge = pfLightCandidates->charge().data();
+        const double * ptv    = pfLightCandidates->pt().data();
+        const double * pxv    = pfLightCandidates->px().data();
+        const double * pyv    = pfLightCandidates->py().data();
+        const double * etav   = pfLightCandidates->eta().data();
+        for (unsigned int j = 0; j < n; ++j) {
+            if (usePFCandidatesCharged_ && charge[j] == 0)  continue;
+
+            if (ptv[j] > minPtJet_ && std::abs(etav[j]) < maxEtaJet_) {
+                mhx -= pxv[j];
+                mhy -= pyv[j];
+                sumet += ptv[j];
+                ++nj;
+            }
+        }
+
     } else if ((usePFCandidatesCharged_ || usePFCandidates_) && pfCandidates->size() > 0) {
         for (reco::PFCandidateCollection::const_iterator j = pfCandidates->begin(); j != pfCandidates->end(); ++j) {
             if (usePFCandidatesCharged_ && j->charge() == 0)  continue;
@@ -154,7 +179,13 @@ void HLTTrackMETProducer::produce(edm::Event& iEvent, const edm::EventSetup& iSe
         }
     }
 
-    if (excludePFMuons_) {
+    if (excludePFMuons_ && usePFLightCandidates_) {
+        const std::vector<unsigned int> & muons = pfLightCandidates->muons();
+        for (unsigned int i = 0; i < muons.size(); ++i) {
+            mhx += pfLightCandidates->px()[muons[i]];
+            mhy += pfLightCandidates->py()[muons[i]];
+        }
+    } else if (excludePFMuons_) {
         for (reco::PFCandidateCollection::const_iterator j = pfCandidates->begin(); j != pfCandidates->end(); ++j) {
             if (std::abs(j->pdgId()) == 13) {
                 mhx += j->px();
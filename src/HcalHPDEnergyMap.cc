@@ -0,0 +1,111 @@
+#include "HLTrigger/JetMET/interface/HcalHPDEnergyMap.h"
+
+#include <vector>
+
+
+namespace {
+  // compact index of the HB/HE channels: subdetector, side, |ieta| in 1-29, iphi in 1-72, depth in 1-3
+  const int kMaxIEta  = 29;
+  const int kMaxIPhi  = 72;
+  const int kMaxDepth = 3;
+  const unsigned int kChannels = 2 * 2 * kMaxIEta * kMaxIPhi * kMaxDepth;
+
+  // returns kChannels for the channels outside of the table
+  unsigned int channelIndex(HcalDetId id) {
+    int subdet = id.subdet();
+    if (subdet != HcalBarrel && subdet != HcalEndcap) return kChannels;
+    if (id.ietaAbs() < 1 || id.ietaAbs() > kMaxIEta) return kChannels;
+    if (id.iphi() < 1 || id.iphi() > kMaxIPhi) return kChannels;
+    if (id.depth() < 1 || id.depth() > kMaxDepth) return kChannels;
+    unsigned int index = (subdet == HcalEndcap ? 2 : 0) + (id.zside() > 0 ? 1 : 0);
+    index = index * kMaxIEta  + (id.ietaAbs() - 1);
+    index = index * kMaxIPhi  + (id.iphi() - 1);
+    index = index * kMaxDepth + (id.depth() - 1);
+    return index;
+  }
+
+  // position in the energy map of each channel, evaluated once with HcalHPDEnergyMap::hpdId
+  struct HPDTable {
+    std::vector<unsigned short> position;
+
+    HPDTable() : position(kChannels) {
+      for (int subdet = HcalBarrel; subdet <= HcalEndcap; ++subdet)
+        for (int zside = -1; zside <= 1; zside += 2)
+          for (int ieta = 1; ieta <= kMaxIEta; ++ieta)
+            for (int iphi = 1; iphi <= kMaxIPhi; ++iphi)
+              for (int depth = 1; depth <= kMaxDepth; ++depth) {
+                HcalDetId id((HcalSubdetector) subdet, zside * ieta, iphi, depth);
+                std::pair<HcalHPDEnergyMap::Partition,int> hpd = HcalHPDEnergyMap::hpdId(id);
+                position[channelIndex(id)] = hpd.first * HcalHPDEnergyMap::kHPDs + hpd.second;
+              }
+    }
+  };
+
+  const HPDTable& hpdTable() {
+    static const HPDTable table;
+    return table;
+  }
+}
+
+
+void HcalHPDEnergyMap::fill(const HBHERecHitCollection& hits, double threshold)
+{
+  const std::vector<unsigned short>& position = hpdTable().position;
+  float* energy = &energy_[0];
+  threshold_ = threshold;
+  for (HBHERecHitCollection::const_iterator hit = hits.begin(); hit != hits.end(); ++hit) {
+    if (hit->energy() > threshold) {
+      unsigned int index = channelIndex(hit->id());
+      if (index < kChannels) {
+        energy[position[index]] += hit->energy();
+      }
+      else {
+        std::pair<Partition,int> hpd = hpdId(hit->id());
+        if (hpd.second >= 0 && hpd.second < (int) kHPDs) energy[hpd.first * kHPDs + hpd.second] += hit->energy();
+      }
+    }
+  }
+}
+
+std::pair<HcalHPDEnergyMap::Partition,int> HcalHPDEnergyMap::hpdId (HcalDetId fId) {
+  int hpd = fId.iphi ();
+  Partition partition = HBM;
+  if (fId.subdet() == HcalBarrel) {
+    partition = fId.ieta() > 0 ? HBP : HBM;
+  }
+  else if (fId.subdet() == HcalEndcap) {
+    partition = fId.ieta() > 0 ? HEP : HEM;
+    if ((fId.iphi ()-1) % 4 < 2) { // 1,2 
+	switch (fId.ieta()) { // 1->2
+	case 22:
+	case 24:
+	case 26:
+	case 28:
+	  hpd = +1;
+	  break;
+	case 29:
+	  if (fId.depth () == 1 || fId.depth () == 3) hpd += 1;
+	  break;
+	default:
+	  break;
+	}
+    }
+    else { // 3,4
+	switch (fId.ieta()) { // 3->4
+	case 21:
+	case 23:
+	case 25:
+	case 27:
+	  hpd += 1;
+	  break;
+	case 29:
+	  if (fId.depth () == 2) hpd += 1;
+	  break;
+	default:
+	  break;
+	}
+    }
+  }
+  return std::pair<Partition,int> (partition, hpd);
+}
+
@@ -0,0 +1,298 @@
+#include "HLTrigger/JetMET/interface/HcalNoiseRBXSelector.h"
+
+#include <algorithm>
+#include <sstream>
+
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+
+namespace {
+  // orders RBX positions by decreasing energy
+  struct energycomp {
+    explicit energycomp(const std::vector<CommonHcalNoiseRBXData>& data) : data_(data) { }
+    bool operator() (unsigned int i, unsigned int j) const {
+      return data_[i].energy()>data_[j].energy();
+    }
+    const std::vector<CommonHcalNoiseRBXData>& data_;
+  };
+
+  const char* const criterionNames[HcalNoiseRBXSummary::kNCriteria] = {
+    "minRatio", "maxRatio", "minHPDHits", "minRBXHits", "minHPDNoOtherHits", "minZeros",
+    "minHighEHitTime", "maxHighEHitTime", "TS4TS5", "maxRBXEMF"
+  };
+
+  // FNV-1a hash of the bit patterns of the values
+  unsigned int fingerprint(const std::vector<double>& values) {
+    unsigned int hash = 2166136261U;
+    for(unsigned int i = 0; i < values.size(); ++i) {
+      const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&values[i]);
+      for(unsigned int k = 0; k < sizeof(double); ++k) {
+        hash ^= bytes[k];
+        hash *= 16777619U;
+      }
+    }
+    return hash;
+  }
+}
+
+
+HcalNoiseRBXSelector::HcalNoiseRBXSelector(const edm::ParameterSet& iConfig) :
+  evaluated_(0),
+  needEMFCoincidence_(iConfig.getParameter<bool>("needEMFCoincidence")),
+  minRBXEnergy_(iConfig.getParameter<double>("minRBXEnergy")),
+  minRatio_(iConfig.getParameter<double>("minRatio")),
+  maxRatio_(iConfig.getParameter<double>("maxRatio")),
+  minHPDHits_(iConfig.getParameter<int>("minHPDHits")),
+  minRBXHits_(iConfig.getParameter<int>("minRBXHits")),
+  minHPDNoOtherHits_(iConfig.getParameter<int>("minHPDNoOtherHits")),
+  minZeros_(iConfig.getParameter<int>("minZeros")),
+  minHighEHitTime_(iConfig.getParameter<double>("minHighEHitTime")),
+  maxHighEHitTime_(iConfig.getParameter<double>("maxHighEHitTime")),
+  maxRBXEMF_(iConfig.getParameter<double>("maxRBXEMF")),
+  minRecHitE_(iConfig.getParameter<double>("minRecHitE")),
+  minLowHitE_(iConfig.getParameter<double>("minLowHitE")),
+  minHighHitE_(iConfig.getParameter<double>("minHighHitE")),
+  TS4TS5EnergyThreshold_(iConfig.getParameter<double>("TS4TS5EnergyThreshold"))
+{
+  std::vector<double> TS4TS5UpperThresholdTemp = iConfig.getParameter<std::vector<double> >("TS4TS5UpperThreshold");
+  std::vector<double> TS4TS5UpperCutTemp = iConfig.getParameter<std::vector<double> >("TS4TS5UpperCut");
+  std::vector<double> TS4TS5LowerThresholdTemp = iConfig.getParameter<std::vector<double> >("TS4TS5LowerThreshold");
+  std::vector<double> TS4TS5LowerCutTemp = iConfig.getParameter<std::vector<double> >("TS4TS5LowerCut");
+
+  for(int i = 0; i < (int)TS4TS5UpperThresholdTemp.size() && i < (int)TS4TS5UpperCutTemp.size(); i++)
+     TS4TS5UpperCut_.push_back(std::pair<double, double>(TS4TS5UpperThresholdTemp[i], TS4TS5UpperCutTemp[i]));
+  sort(TS4TS5UpperCut_.begin(), TS4TS5UpperCut_.end());
+
+  for(int i = 0; i < (int)TS4TS5LowerThresholdTemp.size() && i < (int)TS4TS5LowerCutTemp.size(); i++)
+     TS4TS5LowerCut_.push_back(std::pair<double, double>(TS4TS5LowerThresholdTemp[i], TS4TS5LowerCutTemp[i]));
+  sort(TS4TS5LowerCut_.begin(), TS4TS5LowerCut_.end());
+
+  // the settings used to build CommonHcalNoiseRBXData, which summaries from another module must share
+  std::vector<double> settings;
+  settings.push_back(minRecHitE_);
+  settings.push_back(minLowHitE_);
+  settings.push_back(minHighHitE_);
+  settings.push_back(TS4TS5EnergyThreshold_);
+  for(unsigned int i = 0; i < TS4TS5UpperCut_.size(); ++i) {
+    settings.push_back(TS4TS5UpperCut_[i].first);
+    settings.push_back(TS4TS5UpperCut_[i].second);
+  }
+  settings.push_back(TS4TS5UpperCut_.size());
+  for(unsigned int i = 0; i < TS4TS5LowerCut_.size(); ++i) {
+    settings.push_back(TS4TS5LowerCut_[i].first);
+    settings.push_back(TS4TS5LowerCut_[i].second);
+  }
+  settings_ = fingerprint(settings);
+
+  for(unsigned int c = 0; c < HcalNoiseRBXSummary::kNCriteria; ++c)
+    failed_[c] = 0;
+
+  // the noise criteria, in the order of the original cascade
+  addRule(HcalNoiseRBXSummary::kMinRatio,        kRatio,           kLess,         minRatio_);
+  addRule(HcalNoiseRBXSummary::kMaxRatio,        kRatio,           kGreater,      maxRatio_);
+  addRule(HcalNoiseRBXSummary::kHPDHits,         kHPDHits,         kGreaterEqual, minHPDHits_);
+  addRule(HcalNoiseRBXSummary::kRBXHits,         kRBXHits,         kGreaterEqual, minRBXHits_);
+  addRule(HcalNoiseRBXSummary::kHPDNoOtherHits,  kHPDNoOtherHits,  kGreaterEqual, minHPDNoOtherHits_);
+  addRule(HcalNoiseRBXSummary::kZeros,           kZeros,           kGreaterEqual, minZeros_);
+  addRule(HcalNoiseRBXSummary::kMinHighEHitTime, kMinHighEHitTime, kLess,         minHighEHitTime_);
+  addRule(HcalNoiseRBXSummary::kMaxHighEHitTime, kMaxHighEHitTime, kGreater,      maxHighEHitTime_);
+  addRule(HcalNoiseRBXSummary::kTS4TS5,          kFailTS4TS5,      kGreaterEqual, 1.);
+  addRule(HcalNoiseRBXSummary::kRBXEMF,          kRBXEMF,          kLess,         maxRBXEMF_);
+}
+
+void
+HcalNoiseRBXSelector::addRule(HcalNoiseRBXSummary::Criterion criterion, Quantity quantity, Comparison comparison, double threshold) {
+  Rule rule = { criterion, quantity, comparison, threshold };
+  rules_.push_back(rule);
+}
+
+void
+HcalNoiseRBXSelector::fillDescription(edm::ParameterSetDescription& desc) {
+  desc.add<bool>("needEMFCoincidence",true);
+  desc.add<double>("minRBXEnergy",50.0);
+  desc.add<double>("minRatio",-999.);
+  desc.add<double>("maxRatio",999.);
+  desc.add<int>("minHPDHits",17);
+  desc.add<int>("minRBXHits",999);
+  desc.add<int>("minHPDNoOtherHits",10);
+  desc.add<int>("minZeros",10);
+  desc.add<double>("minHighEHitTime",-9999.0);
+  desc.add<double>("maxHighEHitTime",9999.0);
+  desc.add<double>("maxRBXEMF",0.02);
+  desc.add<double>("minRecHitE",1.5);
+  desc.add<double>("minLowHitE",10.0);
+  desc.add<double>("minHighHitE",25.0);
+  desc.add<double>("TS4TS5EnergyThreshold",50.0);
+
+  double TS4TS5UpperThresholdArray[5] = {70, 90, 100, 400, 4000 };
+  double TS4TS5UpperCutArray[5] = {1, 0.8, 0.75, 0.72, 0.72};
+  double TS4TS5LowerThresholdArray[7] = {100, 120, 150, 200, 300, 400, 500};
+  double TS4TS5LowerCutArray[7] = {-1, -0.7, -0.4, -0.2, -0.08, 0, 0.1};
+  std::vector<double> TS4TS5UpperThreshold(TS4TS5UpperThresholdArray, TS4TS5UpperThresholdArray+5);
+  std::vector<double> TS4TS5UpperCut(TS4TS5UpperCutArray, TS4TS5UpperCutArray+5);
+  std::vector<double> TS4TS5LowerThreshold(TS4TS5LowerThresholdArray, TS4TS5LowerThresholdArray+7);
+  std::vector<double> TS4TS5LowerCut(TS4TS5LowerCutArray, TS4TS5LowerCutArray+7);
+
+  desc.add<std::vector<double> >("TS4TS5UpperThreshold", TS4TS5UpperThreshold);
+  desc.add<std::vector<double> >("TS4TS5UpperCut", TS4TS5UpperCut);
+  desc.add<std::vector<double> >("TS4TS5LowerThreshold", TS4TS5LowerThreshold);
+  desc.add<std::vector<double> >("TS4TS5LowerCut", TS4TS5LowerCut);
+}
+
+template <class T>
+void
+HcalNoiseRBXSelector::criteria(const std::vector<T>& data, std::vector<unsigned int>& criteria) const {
+  const unsigned int n = data.size();
+  criteria.assign(n, 0);
+  if(n==0) return;
+
+  // one array per quantity; the criteria only apply to RBXs above minRBXEnergy,
+  // and the ratio criteria only if the ratio is valid
+  std::vector<double> quantities(kNQuantities*n);
+  std::vector<unsigned int> mask(n);
+  const unsigned int ratioBits = (1U << HcalNoiseRBXSummary::kMinRatio) | (1U << HcalNoiseRBXSummary::kMaxRatio);
+  for(unsigned int i = 0; i < n; ++i) {
+    const T& d = data[i];
+    quantities[kRatio*n + i]           = d.ratio();
+    quantities[kHPDHits*n + i]         = d.numHPDHits();
+    quantities[kRBXHits*n + i]         = d.numRBXHits();
+    quantities[kHPDNoOtherHits*n + i]  = d.numHPDNoOtherHits();
+    quantities[kZeros*n + i]           = d.numZeros();
+    quantities[kMinHighEHitTime*n + i] = d.minHighEHitTime();
+    quantities[kMaxHighEHitTime*n + i] = d.maxHighEHitTime();
+    quantities[kFailTS4TS5*n + i]      = d.PassTS4TS5() ? 0. : 1.;
+    quantities[kRBXEMF*n + i]          = d.RBXEMF();
+    mask[i] = (d.energy()>minRBXEnergy_) ? (d.validRatio() ? ~0U : ~ratioBits) : 0U;
+  }
+
+  unsigned int* bits = &criteria.front();
+  for(std::vector<Rule>::const_iterator rule = rules_.begin(); rule != rules_.end(); ++rule) {
+    const double* x = &quantities[rule->quantity*n];
+    const double threshold = rule->threshold;
+    const unsigned int shift = rule->criterion;
+    switch(rule->comparison) {
+    case kLess:
+      for(unsigned int i = 0; i < n; ++i) bits[i] |= static_cast<unsigned int>(x[i] <  threshold) << shift;
+      break;
+    case kGreater:
+      for(unsigned int i = 0; i < n; ++i) bits[i] |= static_cast<unsigned int>(x[i] >  threshold) << shift;
+      break;
+    case kGreaterEqual:
+      for(unsigned int i = 0; i < n; ++i) bits[i] |= static_cast<unsigned int>(x[i] >= threshold) << shift;
+      break;
+    }
+  }
+
+  unsigned long failed[HcalNoiseRBXSummary::kNCriteria] = { 0 };
+  for(unsigned int i = 0; i < n; ++i) {
+    bits[i] &= mask[i];
+    for(unsigned int c = 0; c < HcalNoiseRBXSummary::kNCriteria; ++c)
+      failed[c] += (bits[i] >> c) & 1U;
+  }
+
+  evaluated_.fetch_add(n, std::memory_order_relaxed);
+  for(unsigned int c = 0; c < HcalNoiseRBXSummary::kNCriteria; ++c)
+    if(failed[c]) failed_[c].fetch_add(failed[c], std::memory_order_relaxed);
+}
+
+template void HcalNoiseRBXSelector::criteria(const std::vector<CommonHcalNoiseRBXData>&, std::vector<unsigned int>&) const;
+template void HcalNoiseRBXSelector::criteria(const std::vector<HcalNoiseRBXSummary>&, std::vector<unsigned int>&) const;
+
+void
+HcalNoiseRBXSelector::select(const HcalNoiseRBXSummaryCollection& summaries, HcalNoiseRBXSummaryCollection& selected, int maxRBXs) const {
+  selected.clear();
+  if(summaries.empty()) return;
+
+  if(summaries.front().settings()!=settings_)
+    throw cms::Exception("Configuration")
+      << "HcalNoiseRBXSummary computed with different minRecHitE, minLowHitE, minHighHitE or TS4TS5 parameters:"
+      << " they must be the same as in the module producing the summaries.\n";
+
+  const unsigned int n = (maxRBXs>=0 && maxRBXs<static_cast<int>(summaries.size())) ? maxRBXs : summaries.size();
+  selected.assign(summaries.begin(), summaries.begin()+n);
+
+  std::vector<unsigned int> failed;
+  criteria(selected, failed);
+  for(unsigned int i = 0; i < n; ++i)
+    selected[i].setCriteria(failed[i]);
+}
+
+void
+HcalNoiseRBXSelector::report(const std::string& module) const {
+  if(evaluated()==0) return;
+
+  std::ostringstream out;
+  out << module << ": " << evaluated() << " RBXs evaluated, failing:";
+  for(unsigned int c = 0; c < HcalNoiseRBXSummary::kNCriteria; ++c)
+    out << " " << criterionNames[c] << "=" << failed(static_cast<HcalNoiseRBXSummary::Criterion>(c));
+  edm::LogInfo("HcalNoiseRBXSelector") << out.str();
+}
+
+void
+HcalNoiseRBXSelector::summarize(const reco::HcalNoiseRBXCollection& rbxs, HcalNoiseRBXSummaryCollection& summaries, int maxRBXs) const {
+  summaries.clear();
+
+  if(maxRBXs>=0 && maxRBXs<static_cast<int>(rbxs.size())) {
+    // CommonHcalNoiseRBXData::energy() is the rec hit energy of the RBX, which is much
+    // cheaper to compute alone: use it to pick the leading RBXs, one pass per selected RBX
+    std::vector<double> energies;
+    energies.reserve(rbxs.size());
+    for(reco::HcalNoiseRBXCollection::const_iterator it=rbxs.begin(); it!=rbxs.end(); ++it)
+      energies.push_back(it->recHitEnergy(minRecHitE_));
+
+    std::vector<unsigned int> selected;
+    selected.reserve(maxRBXs);
+    for(int k = 0; k < maxRBXs; ++k) {
+      int best = -1;
+      for(unsigned int i = 0; i < energies.size(); ++i) {
+        // below the previous RBX, and the first one among those with the same energy
+        if(k>0 && !(energies[i]<energies[selected.back()]))
+          continue;
+        if(best<0 || energies[i]>energies[best])
+          best = i;
+      }
+      if(best<0)
+        break;
+      selected.push_back(best);
+    }
+
+    std::vector<CommonHcalNoiseRBXData> data;
+    data.reserve(selected.size());
+    for(unsigned int k = 0; k < selected.size(); ++k)
+      data.push_back(CommonHcalNoiseRBXData(rbxs[selected[k]], minRecHitE_, minLowHitE_, minHighHitE_, TS4TS5EnergyThreshold_,
+                                            TS4TS5UpperCut_, TS4TS5LowerCut_));
+    std::vector<unsigned int> failed;
+    criteria(data, failed);
+
+    summaries.reserve(selected.size());
+    for(unsigned int k = 0; k < selected.size(); ++k)
+      summaries.push_back(HcalNoiseRBXSummary(selected[k], data[k], failed[k], settings_));
+    return;
+  }
+
+  std::vector<CommonHcalNoiseRBXData> data;
+  data.reserve(rbxs.size());
+  for(reco::HcalNoiseRBXCollection::const_iterator it=rbxs.begin(); it!=rbxs.end(); ++it) {
+    data.push_back(CommonHcalNoiseRBXData(*it, minRecHitE_, minLowHitE_, minHighHitE_, TS4TS5EnergyThreshold_,
+                                          TS4TS5UpperCut_, TS4TS5LowerCut_));
+  }
+
+  // sort by energy, keeping the first RBX among those with the same energy
+  std::vector<unsigned int> order(data.size());
+  for(unsigned int i = 0; i < order.size(); ++i)
+    order[i] = i;
+  std::stable_sort(order.begin(), order.end(), energycomp(data));
+
+  std::vector<unsigned int> failed;
+  criteria(data, failed);
+
+  summaries.reserve(order.size());
+  for(unsigned int i = 0; i < order.size(); ++i) {
+    const CommonHcalNoiseRBXData& d = data[order[i]];
+    if(!summaries.empty() && !(d.energy()<summaries.back().energy()))
+      continue;
+    summaries.push_back(HcalNoiseRBXSummary(order[i], d, failed[order[i]], settings_));
+  }
+}
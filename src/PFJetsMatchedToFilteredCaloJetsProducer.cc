@@ -1,5 +1,5 @@
 #include "HLTrigger/JetMET/interface/PFJetsMatchedToFilteredCaloJetsProducer.h"
-#include "Math/GenVector/VectorUtil.h"
+#include "HLTrigger/JetMET/interface/EtaPhiGrid.h"
 #include "DataFormats/HLTReco/interface/TriggerTypeDefs.h"
 #include "FWCore/Utilities/interface/EDMException.h"
 
@@ -63,20 +63,23 @@ void PFJetsMatchedToFilteredCaloJetsProducer::produce(edm::Event& iEvent, const
 	// std::cout <<"Size of input triggered jet collection "<<jetRefVec.size()<<std::endl;
 	math::XYZPoint a(0.,0.,0.);
 	PFJet::Specific f;
-		
+
+	// PF jets in eta-phi cells of size DeltaR
+	EtaPhiGrid pfJetGrid(DeltaR_);
+	for(unsigned int iPF=0;iPF<PFJets->size();iPF++)
+	  pfJetGrid.add((*PFJets)[iPF].eta(), (*PFJets)[iPF].phi());
+	pfJetGrid.build();
+
 	for( unsigned int iCalo=0; iCalo <jetRefVec.size();iCalo++)
 	  {  
 	    // std::cout << "\tiTriggerJet: " << iCalo << " pT= " << jetRefVec[iCalo]->pt() << std::endl;
-	    for(unsigned int iPF=0;iPF<PFJets->size();iPF++)
-	      {
-		const Candidate &  myJet = (*PFJets)[iPF];
-		double deltaR = ROOT::Math::VectorUtil::DeltaR(myJet.p4().Vect(), (jetRefVec[iCalo]->p4()).Vect());
-		if(deltaR < DeltaR_ ) {
-		  PFJet myPFJet(myJet.p4(),a,f);
-		  pfjets->push_back(myPFJet);
-		  break;
-		}
-	      }
+	    // the first PF jet within DeltaR
+	    const int matched = pfJetGrid.first(jetRefVec[iCalo]->eta(), jetRefVec[iCalo]->phi());
+	    if(matched >= 0) {
+	      const Candidate &  myJet = (*PFJets)[matched];
+	      PFJet myPFJet(myJet.p4(),a,f);
+	      pfjets->push_back(myPFJet);
+	    }
 	  }  
 			
 	// std::cout <<"Size of PF matched jets "<<pfjets->size()<<std::endl;
@@ -21,6 +21,7 @@
 
 // system include files
 #include <memory>
+#include <cmath>
 
 // user include files
 #include "FWCore/Framework/interface/Frameworkfwd.h"
@@ -45,7 +46,35 @@
 #include "TrackingTools/TransientTrack/interface/TransientTrackBuilder.h"
 #include "TrackingTools/Records/interface/TransientTrackRecord.h"
 
-#include "DataFormats/Math/interface/deltaR.h"
+#include "HLTrigger/JetMET/interface/EtaPhiGrid.h"
+
+namespace {
+  // distance between the straight line of the track, through its reference point,
+  // and the jet axis through the primary vertex: for pixel tracks close to the beam
+  // line this approximates IPTools::jetTrackDistance without propagating the track;
+  // that one is always -|d| (unweighted), so the cut below is on the magnitude alone
+  double fastJetTrackDistance(const reco::Track& track, const GlobalVector& direction, const reco::Vertex& pv) {
+    const double dx = track.vx() - pv.x();
+    const double dy = track.vy() - pv.y();
+    const double dz = track.vz() - pv.z();
+    const double jx = direction.x(), jy = direction.y(), jz = direction.z();
+    const double tx = track.px(), ty = track.py(), tz = track.pz();
+    // common normal of the two lines
+    const double nx = jy*tz - jz*ty;
+    const double ny = jz*tx - jx*tz;
+    const double nz = jx*ty - jy*tx;
+    const double n2 = nx*nx + ny*ny + nz*nz;
+    const double j2 = jx*jx + jy*jy + jz*jz;
+    if (n2 <= 1e-12 * j2 * (tx*tx + ty*ty + tz*tz)) {
+      // parallel lines: distance of the reference point to the jet axis
+      const double cx = dy*jz - dz*jy;
+      const double cy = dz*jx - dx*jz;
+      const double cz = dx*jy - dy*jx;
+      return std::sqrt((cx*cx + cy*cy + cz*cz) / j2);
+    }
+    return std::abs(dx*nx + dy*ny + dz*nz) / std::sqrt(n2);
+  }
+}
      
 //
 // class declaration
@@ -73,6 +102,8 @@ class PixelJetPuId : public edm::EDProducer {
      double m_MinTrackPt; 
      double m_MaxTrackChi2; 
      double m_MaxTrackDistanceToJet; 
+     bool   m_fastDistance;           // use fastJetTrackDistance() away from the cut
+     double m_fastDistanceMargin;     // IPTools is used within this margin of MaxTrackDistanceToJet
 
      bool   m_fwjets;
      double m_mineta_fwjets;
@@ -80,13 +111,21 @@ class PixelJetPuId : public edm::EDProducer {
 
      double m_MinGoodJetTrackPt;
      double m_MinGoodJetTrackPtRatio; 
+
+     // per-event track buffers, kept to reuse their memory
+     EtaPhiGrid m_trackGrid;                              // selected tracks within deltaR < 0.5 of the jets
+     std::vector<unsigned int> m_selectedTracks;          // positions of the selected tracks
+     std::vector<unsigned int> m_jetTracks;
+     std::vector<reco::TransientTrack> m_transientTracks; // built the first time a jet needs them
+     std::vector<bool> m_transientTrackBuilt;
 };
 
 
 //
 // constructors and destructor
 //
-PixelJetPuId::PixelJetPuId(const edm::ParameterSet& iConfig)
+PixelJetPuId::PixelJetPuId(const edm::ParameterSet& iConfig) :
+  m_trackGrid(0.5)
 {
   //InputTag
   m_tracks           = iConfig.getParameter<edm::InputTag>("tracks");
@@ -100,6 +139,8 @@ PixelJetPuId::PixelJetPuId(const edm::ParameterSet& iConfig)
   m_MinTrackPt             = iConfig.getParameter<double>("MinTrackPt");
   m_MaxTrackDistanceToJet  = iConfig.getParameter<double>("MaxTrackDistanceToJet");
   m_MaxTrackChi2           = iConfig.getParameter<double>("MaxTrackChi2");
+  m_fastDistance           = iConfig.getParameter<bool>("UseFastTrackDistance");
+  m_fastDistanceMargin     = iConfig.getParameter<double>("FastTrackDistanceMargin");
 
   //A jet is defined as a signal jet if Sum(trackPt) > minPt or Sum(comp.trackPt)/CaloJetPt > minPtRatio
   m_MinGoodJetTrackPt      = iConfig.getParameter<double>("MinGoodJetTrackPt");
@@ -128,6 +169,8 @@ PixelJetPuId::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
   desc.add<double>("MaxTrackDistanceToJet",0.04);
   desc.add<double>("MinTrackPt",0.6);
   desc.add<double>("MaxTrackChi2",20.);
+  desc.add<bool>("UseFastTrackDistance",false);
+  desc.add<double>("FastTrackDistanceMargin",0.01);
   desc.add<bool>("UseForwardJetsAsNoPU",true);
   desc.add<double>("MinEtaForwardJets",2.4);
   desc.add<double>("MinEtForwardJets",40.);
@@ -148,10 +191,22 @@ void PixelJetPuId::produce(edm::Event& iEvent, const edm::EventSetup& iSetup)
    //get tracks
   Handle<std::vector<reco::Track> > tracks;
   iEvent.getByToken(tracksToken, tracks);
-  unsigned int tsize = tracks->size();
-  float teta[tsize], tphi[tsize];
-  unsigned int i=0;
-  for (auto const & tr : *tracks) { teta[i]=tr.eta(); tphi[i]=tr.phi();++i;}
+  // tracks passing the pt and chi2 cuts, in eta-phi cells to find those within deltaR < 0.5 of the jets
+  m_selectedTracks.clear();
+  m_trackGrid.clear();
+  for (unsigned int i=0; i<tracks->size(); ++i) {
+    const reco::Track & tr = (*tracks)[i];
+    if (( tr.pt() > m_MinTrackPt) && ( tr.normalizedChi2() < m_MaxTrackChi2)) {
+      m_selectedTracks.push_back(i);
+      m_trackGrid.add(tr.eta(), tr.phi());
+    }
+  }
+  m_trackGrid.build();
+
+  // transient tracks of the selected tracks, built the first time a jet needs them
+  m_transientTracks.clear();
+  m_transientTracks.resize(m_selectedTracks.size());
+  m_transientTrackBuilt.assign(m_selectedTracks.size(), false);
    
   //get jets
   Handle<edm::View<reco::CaloJet> > jets;
@@ -185,20 +240,28 @@ void PixelJetPuId::produce(edm::Event& iEvent, const edm::EventSetup& iSetup)
 	  }
 	else 
 	  {
-	    std::vector<reco::Track>::const_iterator itTrack = tracks->begin();
-	    for (unsigned int i=0; i<tsize; ++i) {
-	      float deltaR2=reco::deltaR2(itJet->eta(),itJet->phi(), teta[i],tphi[i]);
-	      if(deltaR2<0.25) {
-		reco::TransientTrack transientTrack = builder->build(*itTrack);
-		float jetTrackDistance = -((IPTools::jetTrackDistance(transientTrack, direction, *pv)).second).value();
-		    
-		//select the tracks compabible with the jet
-		if(( itTrack->pt() > m_MinTrackPt) && ( itTrack->normalizedChi2() < m_MaxTrackChi2) && (jetTrackDistance<m_MaxTrackDistanceToJet))
-		  {
-		    trMomentum += itTrack->momentum(); //calculate the Sum(trackPt)
-		  }
+	    m_trackGrid.within(itJet->eta(), itJet->phi(), m_jetTracks);
+	    for (unsigned int i=0; i<m_jetTracks.size(); ++i) {
+	      const unsigned int t = m_jetTracks[i];
+	      std::vector<reco::Track>::const_iterator itTrack = tracks->begin() + m_selectedTracks[t];
+	      float jetTrackDistance = 0;
+	      double fastDistance = m_fastDistance ? fastJetTrackDistance(*itTrack, direction, *pv) : 0.;
+	      if (m_fastDistance && std::abs(fastDistance - m_MaxTrackDistanceToJet) > m_fastDistanceMargin) {
+		jetTrackDistance = fastDistance;
 	      }
-	      itTrack++;
+	      else {
+		if (!m_transientTrackBuilt[t]) {
+		  m_transientTracks[t] = builder->build(*itTrack);
+		  m_transientTrackBuilt[t] = true;
+		}
+		jetTrackDistance = -((IPTools::jetTrackDistance(m_transientTracks[t], direction, *pv)).second).value();
+	      }
+		    
+	      //select the tracks compabible with the jet
+	      if(jetTrackDistance<m_MaxTrackDistanceToJet)
+		{
+		  trMomentum += itTrack->momentum(); //calculate the Sum(trackPt)
+		}
 	    }
 	    //if Sum(comp.trackPt)/CaloJetPt > minPtRatio or Sum(trackPt) > minPt  the jet is a signal jet
 	    if(trMomentum.rho()/jetMomentum.rho() > m_MinGoodJetTrackPtRatio || trMomentum.rho() > m_MinGoodJetTrackPt ) 
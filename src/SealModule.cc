@@ -16,6 +16,8 @@
 #include "HLTrigger/JetMET/interface/HLTHcalMETNoiseFilter.h"
 #include "HLTrigger/JetMET/interface/HLTHcalLaserFilter.h"
 #include "HLTrigger/JetMET/interface/HLTHcalTowerNoiseCleaner.h"
+#include "HLTrigger/JetMET/interface/HLTHcalNoiseRBXSummaryProducer.h"
+#include "HLTrigger/JetMET/interface/HLTHcalHPDEnergyMapProducer.h"
 #include "HLTrigger/JetMET/interface/PFJetsMatchedToFilteredCaloJetsProducer.h"
 #include "HLTrigger/JetMET/interface/HLTNVFilter.h"
 #include "HLTrigger/JetMET/interface/HLTCaloJetIDProducer.h"
@@ -25,7 +27,12 @@
 //Work with all jet collections without changing the module name
 #include "HLTrigger/JetMET/interface/HLTHtMhtProducer.h"
 #include "HLTrigger/JetMET/interface/HLTMhtProducer.h"
+#include "HLTrigger/JetMET/interface/HLTMultiHtMhtProducer.h"
+#include "HLTrigger/JetMET/interface/HLTHtMhtTableProducer.h"
+#include "HLTrigger/JetMET/interface/HLTHtMhtTableFilter.h"
 #include "HLTrigger/JetMET/interface/HLTTrackMETProducer.h"
+#include "HLTrigger/JetMET/interface/HLTPFLightCandidateProducer.h"
+#include "HLTrigger/JetMET/interface/HLTJetKinematicsProducer.h"
 #include "HLTrigger/JetMET/interface/HLTMinDPhiMETFilter.h"
 
 //Template
@@ -139,6 +146,8 @@ DEFINE_FWK_MODULE(HLTHcalMETNoiseFilter);
 DEFINE_FWK_MODULE(HLTHcalMETNoiseCleaner);
 DEFINE_FWK_MODULE(HLTHcalLaserFilter);
 DEFINE_FWK_MODULE(HLTHcalTowerNoiseCleaner);
+DEFINE_FWK_MODULE(HLTHcalNoiseRBXSummaryProducer);
+DEFINE_FWK_MODULE(HLTHcalHPDEnergyMapProducer);
 DEFINE_FWK_MODULE(HLTNVFilter);
 DEFINE_FWK_MODULE(PFJetsMatchedToFilteredCaloJetsProducer);
 DEFINE_FWK_MODULE(HLTMETCleanerUsingJetID);
@@ -146,7 +155,12 @@ DEFINE_FWK_MODULE(HLTMETCleanerUsingJetID);
 //Work with all jet collections without changing the module name
 DEFINE_FWK_MODULE(HLTMhtProducer);
 DEFINE_FWK_MODULE(HLTHtMhtProducer);
+DEFINE_FWK_MODULE(HLTMultiHtMhtProducer);
+DEFINE_FWK_MODULE(HLTHtMhtTableProducer);
+DEFINE_FWK_MODULE(HLTHtMhtTableFilter);
 DEFINE_FWK_MODULE(HLTTrackMETProducer);
+DEFINE_FWK_MODULE(HLTPFLightCandidateProducer);
+DEFINE_FWK_MODULE(HLTJetKinematicsProducer);
 DEFINE_FWK_MODULE(HLTMinDPhiMETFilter);
 
 //Templates
@@ -0,0 +1,35 @@
+// Dictionaries of the per-event products that the modules of this package exchange.
+// They stay in this plugin library rather than in a DataFormats package: no other package
+// produces or reads them, and HcalNoiseRBXSummary and HcalHPDEnergyMap are filled by
+// code (HcalNoiseRBXSelector, HcalHPDEnergyMap.cc) that is only built here. A product
+// meant to be read by other packages belongs in a DataFormats library instead.
+
+#include "DataFormats/Common/interface/Wrapper.h"
+
+#include "HLTrigger/JetMET/interface/HcalHPDEnergyMap.h"
+#include "HLTrigger/JetMET/interface/HcalNoiseRBXSummary.h"
+#include "HLTrigger/JetMET/interface/HtMhtTable.h"
+#include "HLTrigger/JetMET/interface/JetKinematics.h"
+#include "HLTrigger/JetMET/interface/PFLightCandidates.h"
+#include "HLTrigger/JetMET/interface/RazorHemispheres.h"
+#include "HLTrigger/JetMET/interface/RazorVariables.h"
+
+namespace HLTrigger_JetMET {
+  struct dictionary {
+    RazorHemispheres                  rh;
+    edm::Wrapper<RazorHemispheres>    wrh;
+    RazorVariables                    rv;
+    edm::Wrapper<RazorVariables>      wrv;
+    HcalNoiseRBXSummary                                 hnrs;
+    std::vector<HcalNoiseRBXSummary>                    vhnrs;
+    edm::Wrapper<std::vector<HcalNoiseRBXSummary> >     wvhnrs;
+    HcalHPDEnergyMap                  hhem;
+    edm::Wrapper<HcalHPDEnergyMap>    whhem;
+    HtMhtTable                        hmt;
+    edm::Wrapper<HtMhtTable>          whmt;
+    PFLightCandidates                 plc;
+    edm::Wrapper<PFLightCandidates>   wplc;
+    JetKinematics                     jk;
+    edm::Wrapper<JetKinematics>       wjk;
+  };
+}